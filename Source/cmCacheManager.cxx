@@ -21,7 +21,6 @@
 #include <cmsys/Directory.hxx>
 #include <cmsys/Glob.hxx>
 #include <cmsys/FStream.hxx>
-#include <cmsys/RegularExpression.hxx>
 
 const char* cmCacheManagerTypes[] =
 { "BOOL",
@@ -39,6 +38,8 @@ cmCacheManager::cmCacheManager(cmake* cm)
   this->CacheMajorVersion = 0;
   this->CacheMinorVersion = 0;
   this->CMakeInstance = cm;
+  this->LoadedTime = 0;
+  this->LoadedSize = 0;
 }
 
 const char* cmCacheManager::TypeToString(cmCacheManager::CacheEntryType type)
@@ -94,42 +95,86 @@ bool cmCacheManager::LoadCache(const std::string& path,
   return this->LoadCache(path, internal, emptySet, emptySet);
 }
 
-static bool ParseEntryWithoutType(const std::string& entry,
-                                  std::string& var,
-                                  std::string& value)
+// Split an entry of the form
+//   key[:type]=value  or  "key"[:type]=value
+// exactly as the regular expressions
+//   ^([^:]*):([^=]*)=(.*[^\r\t ]|[\r\t ]*)[\r\t ]*$
+//   ^"([^"]*)":([^=]*)=(.*[^\r\t ]|[\r\t ]*)[\r\t ]*$
+// (without the ":type" part if typed is false) would, but without the
+// cost of regular expression matching for every line of the cache.
+static bool cmCacheManagerSplitEntry(const char* entry, bool quoted,
+                                     bool typed, std::string& var,
+                                     std::string& type, std::string& value)
 {
-  // input line is:         key=value
-  static cmsys::RegularExpression reg(
-    "^([^=]*)=(.*[^\r\t ]|[\r\t ]*)[\r\t ]*$");
-  // input line is:         "key"=value
-  static cmsys::RegularExpression regQuoted(
-    "^\"([^\"]*)\"=(.*[^\r\t ]|[\r\t ]*)[\r\t ]*$");
-  bool flag = false;
-  if(regQuoted.find(entry))
+  const char* keyBegin = entry;
+  const char* keyEnd;
+  const char* sep;
+  if(quoted)
+    {
+    if(*entry != '"' || !(keyEnd = strchr(entry + 1, '"')))
+      {
+      return false;
+      }
+    keyBegin = entry + 1;
+    sep = keyEnd + 1;
+    if(*sep != (typed? ':' : '='))
+      {
+      return false;
+      }
+    }
+  else
     {
-    var = regQuoted.match(1);
-    value = regQuoted.match(2);
-    flag = true;
+    if(!(keyEnd = strchr(entry, typed? ':' : '=')))
+      {
+      return false;
+      }
+    sep = keyEnd;
     }
-  else if (reg.find(entry))
+  const char* eq = sep;
+  if(typed && !(eq = strchr(sep + 1, '=')))
     {
-    var = reg.match(1);
-    value = reg.match(2);
-    flag = true;
+    return false;
     }
+  var.assign(keyBegin, keyEnd);
+  if(typed)
+    {
+    type.assign(sep + 1, eq);
+    }
+
+  // Drop trailing whitespace unless the value consists only of it.
+  const char* valueBegin = eq + 1;
+  const char* valueEnd = valueBegin + strlen(valueBegin);
+  const char* last = valueEnd;
+  while(last != valueBegin &&
+        (last[-1] == ' ' || last[-1] == '\t' || last[-1] == '\r'))
+    {
+    --last;
+    }
+  value.assign(valueBegin, last == valueBegin? valueEnd : last);
 
   // if value is enclosed in single quotes ('foo') then remove them
   // it is used to enclose trailing space or tab
-  if (flag &&
-      value.size() >= 2 &&
+  if (value.size() >= 2 &&
       value[0] == '\'' &&
       value[value.size() - 1] == '\'')
     {
     value = value.substr(1,
                          value.size() - 2);
     }
+  return true;
+}
 
-  return flag;
+static bool ParseEntryWithoutType(const std::string& entry,
+                                  std::string& var,
+                                  std::string& value)
+{
+  // input line is:         "key"=value
+  // input line is:         key=value
+  std::string type;
+  return (cmCacheManagerSplitEntry(entry.c_str(), true, false,
+                                   var, type, value) ||
+          cmCacheManagerSplitEntry(entry.c_str(), false, false,
+                                   var, type, value));
 }
 
 bool cmCacheManager::ParseEntry(const std::string& entry,
@@ -137,45 +182,43 @@ bool cmCacheManager::ParseEntry(const std::string& entry,
                                 std::string& value,
                                 CacheEntryType& type)
 {
-  // input line is:         key:type=value
-  static cmsys::RegularExpression reg(
-    "^([^:]*):([^=]*)=(.*[^\r\t ]|[\r\t ]*)[\r\t ]*$");
   // input line is:         "key":type=value
-  static cmsys::RegularExpression regQuoted(
-    "^\"([^\"]*)\":([^=]*)=(.*[^\r\t ]|[\r\t ]*)[\r\t ]*$");
-  bool flag = false;
-  if(regQuoted.find(entry))
+  // input line is:         key:type=value
+  std::string typeName;
+  if(cmCacheManagerSplitEntry(entry.c_str(), true, true,
+                              var, typeName, value) ||
+     cmCacheManagerSplitEntry(entry.c_str(), false, true,
+                              var, typeName, value))
     {
-    var = regQuoted.match(1);
-    type = cmCacheManager::StringToType(regQuoted.match(2).c_str());
-    value = regQuoted.match(3);
-    flag = true;
+    type = cmCacheManager::StringToType(typeName.c_str());
+    return true;
     }
-  else if (reg.find(entry))
+  return ParseEntryWithoutType(entry, var, value);
+}
+
+// Get the next line of the cache file content as GetLineFromStream would.
+static bool cmCacheManagerGetLine(std::string const& content,
+                                  std::string::size_type& pos,
+                                  std::string& line)
+{
+  if(pos >= content.size())
     {
-    var = reg.match(1);
-    type = cmCacheManager::StringToType(reg.match(2).c_str());
-    value = reg.match(3);
-    flag = true;
+    line = "";
+    return false;
     }
-
-  // if value is enclosed in single quotes ('foo') then remove them
-  // it is used to enclose trailing space or tab
-  if (flag &&
-      value.size() >= 2 &&
-      value[0] == '\'' &&
-      value[value.size() - 1] == '\'')
+  std::string::size_type end = content.find('\n', pos);
+  if(end == std::string::npos)
     {
-    value = value.substr(1,
-                         value.size() - 2);
+    end = content.size();
     }
-
-  if (!flag)
+  std::string::size_type len = end - pos;
+  if(len > 0 && content[end-1] == '\r')
     {
-    return ParseEntryWithoutType(entry, var, value);
+    --len;
     }
-
-  return flag;
+  line.assign(content, pos, len);
+  pos = end + 1;
+  return true;
 }
 
 void cmCacheManager::CleanCMakeFiles(const std::string& path)
@@ -204,6 +247,8 @@ bool cmCacheManager::LoadCache(const std::string& path,
   if ( internal )
     {
     this->Cache.clear();
+    this->LoadedFile = "";
+    this->LoadedContent = "";
     }
   if(!cmSystemTools::FileExists(cacheFile.c_str()))
     {
@@ -211,21 +256,40 @@ bool cmCacheManager::LoadCache(const std::string& path,
     return false;
     }
 
+  // Read the whole file at once and split it into lines in memory.
+  std::string content;
+  long int mtime = cmSystemTools::ModifiedTime(cacheFile.c_str());
+  unsigned long size = cmSystemTools::FileLength(cacheFile.c_str());
+  {
   cmsys::ifstream fin(cacheFile.c_str());
   if(!fin)
     {
     return false;
     }
+  cmOStringStream contentStream;
+  contentStream << fin.rdbuf();
+  content = contentStream.str();
+  }
+  if ( internal )
+    {
+    this->LoadedFile = cacheFile;
+    this->LoadedContent = content;
+    this->LoadedTime = mtime;
+    this->LoadedSize = size;
+    }
+
+  std::string::size_type pos = 0;
+  bool more = true;
   const char *realbuffer;
   std::string buffer;
   std::string entryKey;
-  while(fin)
+  while(more)
     {
     // Format is key:type=value
     std::string helpString;
     CacheEntry e;
     e.Properties.SetCMakeInstance(this->CMakeInstance);
-    cmSystemTools::GetLineFromStream(fin, buffer);
+    more = cmCacheManagerGetLine(content, pos, buffer);
     realbuffer = buffer.c_str();
     while(*realbuffer != '0' &&
           (*realbuffer == ' ' ||
@@ -251,9 +315,9 @@ bool cmCacheManager::LoadCache(const std::string& path,
         {
         helpString += &realbuffer[2];
         }
-      cmSystemTools::GetLineFromStream(fin, buffer);
+      more = cmCacheManagerGetLine(content, pos, buffer);
       realbuffer = buffer.c_str();
-      if(!fin)
+      if(!more)
         {
         continue;
         }
@@ -432,15 +496,9 @@ bool cmCacheManager::SaveCache(const std::string& path)
 {
   std::string cacheFile = path;
   cacheFile += "/CMakeCache.txt";
-  cmGeneratedFileStream fout(cacheFile.c_str());
-  fout.SetCopyIfDifferent(true);
-  if(!fout)
-    {
-    cmSystemTools::Error("Unable to open cache file for save. ",
-                         cacheFile.c_str());
-    cmSystemTools::ReportLastSystemError("");
-    return false;
-    }
+  // Format the cache in memory first so that the file need not be
+  // written at all if it has not changed since it was loaded.
+  cmOStringStream fout;
   // before writing the cache, update the version numbers
   // to the
   char temp[1024];
@@ -561,7 +619,27 @@ bool cmCacheManager::SaveCache(const std::string& path)
       }
     }
   fout << "\n";
-  fout.Close();
+  std::string content = fout.str();
+  if(!this->IsLoadedContent(cacheFile, content))
+    {
+    cmGeneratedFileStream cacheStream(cacheFile.c_str());
+    cacheStream.SetCopyIfDifferent(true);
+    if(!cacheStream)
+      {
+      cmSystemTools::Error("Unable to open cache file for save. ",
+                           cacheFile.c_str());
+      cmSystemTools::ReportLastSystemError("");
+      return false;
+      }
+    cacheStream << content;
+    if(cacheStream.Close())
+      {
+      this->LoadedFile = cacheFile;
+      this->LoadedContent = content;
+      this->LoadedTime = cmSystemTools::ModifiedTime(cacheFile.c_str());
+      this->LoadedSize = cmSystemTools::FileLength(cacheFile.c_str());
+      }
+    }
   std::string checkCacheFile = path;
   checkCacheFile += cmake::GetCMakeFilesDirectory();
   cmSystemTools::MakeDirectory(checkCacheFile.c_str());
@@ -578,6 +656,14 @@ bool cmCacheManager::SaveCache(const std::string& path)
   return true;
 }
 
+bool cmCacheManager::IsLoadedContent(std::string const& file,
+                                     std::string const& content) const
+{
+  return (file == this->LoadedFile && content == this->LoadedContent &&
+          cmSystemTools::ModifiedTime(file.c_str()) == this->LoadedTime &&
+          cmSystemTools::FileLength(file.c_str()) == this->LoadedSize);
+}
+
 bool cmCacheManager::DeleteCache(const std::string& path)
 {
   std::string cacheFile = path;
@@ -177,6 +177,16 @@ private:
   void WritePropertyEntries(std::ostream& os, CacheIterator const& i);
 
   CacheEntryMap Cache;
+
+  // Content of the cache file as last loaded, used to avoid writing
+  // it again if nothing changed.
+  std::string LoadedFile;
+  std::string LoadedContent;
+  long int LoadedTime;
+  unsigned long LoadedSize;
+  bool IsLoadedContent(std::string const& file,
+                       std::string const& content) const;
+
   // Only cmake and cmMakefile should be able to add cache values
   // the commands should never use the cmCacheManager directly
   friend class cmMakefile; // allow access to add cache values
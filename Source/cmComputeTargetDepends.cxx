@@ -260,9 +260,12 @@ void cmComputeTargetDepends::CollectTargetDepends(int depender_index)
       // Don't emit the same library twice for this target.
       if(emitted.insert(*lib).second)
         {
-        this->AddTargetDepend(depender_index, *lib, true);
-        this->AddInterfaceDepends(depender_index, *lib,
-                                  true, emitted);
+        if(cmTarget const* dependee =
+           this->AddTargetDepend(depender_index, *lib, true))
+          {
+          this->AddInterfaceDepends(depender_index, dependee,
+                                    configs, emitted);
+          }
         }
       }
     }
@@ -290,6 +293,7 @@ void cmComputeTargetDepends::CollectTargetDepends(int depender_index)
 void cmComputeTargetDepends::AddInterfaceDepends(int depender_index,
                                                  cmTarget const* dependee,
                                                  const std::string& config,
+                                      std::vector<std::string> const& configs,
                                                std::set<std::string> &emitted)
 {
   cmTarget const* depender = this->Targets[depender_index];
@@ -303,9 +307,12 @@ void cmComputeTargetDepends::AddInterfaceDepends(int depender_index,
       // Don't emit the same library twice for this target.
       if(emitted.insert(*lib).second)
         {
-        this->AddTargetDepend(depender_index, *lib, true);
-        this->AddInterfaceDepends(depender_index, *lib,
-                                  true, emitted);
+        if(cmTarget const* libTarget =
+           this->AddTargetDepend(depender_index, *lib, true))
+          {
+          this->AddInterfaceDepends(depender_index, libTarget,
+                                    configs, emitted);
+          }
         }
       }
     }
@@ -313,43 +320,31 @@ void cmComputeTargetDepends::AddInterfaceDepends(int depender_index,
 
 //----------------------------------------------------------------------------
 void cmComputeTargetDepends::AddInterfaceDepends(int depender_index,
-                                             const std::string& dependee_name,
-                                             bool linking,
-                                             std::set<std::string> &emitted)
+                                                 cmTarget const* dependee,
+                                      std::vector<std::string> const& configs,
+                                               std::set<std::string> &emitted)
 {
   cmTarget const* depender = this->Targets[depender_index];
-  cmTarget const* dependee =
-    depender->GetMakefile()->FindTargetToUse(dependee_name);
-  // Skip targets that will not really be linked.  This is probably a
-  // name conflict between an external library and an executable
-  // within the project.
-  if(linking && dependee &&
-     dependee->GetType() == cmTarget::EXECUTABLE &&
-     !dependee->IsExecutableWithExports())
-    {
-    dependee = 0;
-    }
-
-  if(dependee)
+  this->AddInterfaceDepends(depender_index, dependee, "", configs, emitted);
+  for (std::vector<std::string>::const_iterator it = configs.begin();
+    it != configs.end(); ++it)
     {
-    this->AddInterfaceDepends(depender_index, dependee, "", emitted);
-    std::vector<std::string> configs;
-    depender->GetMakefile()->GetConfigurations(configs);
-    for (std::vector<std::string>::const_iterator it = configs.begin();
-      it != configs.end(); ++it)
+    if (it->empty())
       {
-      // A target should not depend on itself.
-      emitted.insert(depender->GetName());
-      this->AddInterfaceDepends(depender_index, dependee,
-                                *it, emitted);
+      continue;
       }
+    // A target should not depend on itself.
+    emitted.insert(depender->GetName());
+    this->AddInterfaceDepends(depender_index, dependee,
+                              *it, configs, emitted);
     }
 }
 
 //----------------------------------------------------------------------------
-void cmComputeTargetDepends::AddTargetDepend(int depender_index,
-                                             const std::string& dependee_name,
-                                             bool linking)
+cmTarget const*
+cmComputeTargetDepends::AddTargetDepend(int depender_index,
+                                        const std::string& dependee_name,
+                                        bool linking)
 {
   // Get the depender.
   cmTarget const* depender = this->Targets[depender_index];
@@ -412,6 +407,7 @@ void cmComputeTargetDepends::AddTargetDepend(int depender_index,
     {
     this->AddTargetDepend(depender_index, dependee, linking);
     }
+  return dependee;
 }
 
 //----------------------------------------------------------------------------
@@ -45,17 +45,18 @@ private:
   void CollectTargets();
   void CollectDepends();
   void CollectTargetDepends(int depender_index);
-  void AddTargetDepend(int depender_index,
-                       const std::string& dependee_name,
-                       bool linking);
+  cmTarget const* AddTargetDepend(int depender_index,
+                                  const std::string& dependee_name,
+                                  bool linking);
   void AddTargetDepend(int depender_index, cmTarget const* dependee,
                        bool linking);
   bool ComputeFinalDepends(cmComputeComponentGraph const& ccg);
-  void AddInterfaceDepends(int depender_index,
-                           const std::string& dependee_name,
-                           bool linking, std::set<std::string> &emitted);
+  void AddInterfaceDepends(int depender_index, cmTarget const* dependee,
+                           std::vector<std::string> const& configs,
+                           std::set<std::string> &emitted);
   void AddInterfaceDepends(int depender_index, cmTarget const* dependee,
                            const std::string& config,
+                           std::vector<std::string> const& configs,
                            std::set<std::string> &emitted);
   cmGlobalGenerator* GlobalGenerator;
   bool DebugMode;
@@ -15,7 +15,12 @@
 #include "cmLocalGenerator.h"
 #include "cmGlobalGenerator.h"
 #include "cmExportTryCompileFileGenerator.h"
+#include "cmGeneratedFileStream.h"
 #include <cmsys/Directory.hxx>
+#include <cmsys/FStream.hxx>
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+# include "cmCryptoHash.h"
+#endif
 
 #include <assert.h>
 
@@ -23,6 +28,9 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv)
 {
   this->BinaryDirectory = argv[1].c_str();
   this->OutputFile = "";
+  this->ResultCacheFile = "";
+  this->ResultFromCache = false;
+  this->ResultCacheFields.clear();
   // which signature were we called with ?
   this->SrcFileSignature = true;
 
@@ -477,19 +485,50 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv)
       }
     fclose(fout);
     projectName = "CMAKE_TRY_COMPILE";
+
+    // Results of projects that export targets or whose executable is
+    // needed afterwards depend on more than the project itself.
+    if(!this->ResultCacheContext.empty() && copyFile.empty() &&
+       targets.empty() &&
+       this->Makefile->GetDefinition("CMAKE_TRY_COMPILE_RESULT_CACHE"))
+      {
+      this->LoadResultCache(outFileName, targetName, sources,
+                            cmakeFlags, testLangs);
+      }
     }
 
   bool erroroc = cmSystemTools::GetErrorOccuredFlag();
   cmSystemTools::ResetErrorOccuredFlag();
   std::string output;
-  // actually do the try compile now that everything is setup
-  int res = this->Makefile->TryCompile(sourceDirectory,
-                                       this->BinaryDirectory,
-                                       projectName,
-                                       targetName,
-                                       this->SrcFileSignature,
-                                       &cmakeFlags,
-                                       &output);
+  int res;
+  if(this->ResultFromCache)
+    {
+    res = atoi(this->ResultCacheFields["COMPILE_RESULT"].c_str());
+    output = this->ResultCacheFields["COMPILE_OUTPUT"];
+    }
+  else
+    {
+    // actually do the try compile now that everything is setup
+    res = this->Makefile->TryCompile(sourceDirectory,
+                                     this->BinaryDirectory,
+                                     projectName,
+                                     targetName,
+                                     this->SrcFileSignature,
+                                     &cmakeFlags,
+                                     &output);
+    if(cmSystemTools::GetErrorOccuredFlag())
+      {
+      // Do not store the result of a broken test project.
+      this->ResultCacheFile = "";
+      }
+    else if(!this->ResultCacheFile.empty())
+      {
+      char buf[64];
+      sprintf(buf, "%d", res);
+      this->ResultCacheFields["COMPILE_RESULT"] = buf;
+      this->ResultCacheFields["COMPILE_OUTPUT"] = output;
+      }
+    }
   if ( erroroc )
     {
     cmSystemTools::SetErrorOccured();
@@ -506,7 +545,7 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv)
     this->Makefile->AddDefinition(outputVariable, output.c_str());
     }
 
-  if (this->SrcFileSignature)
+  if (this->SrcFileSignature && !this->ResultFromCache)
     {
     std::string copyFileErrorMessage;
     this->FindOutputFile(targetName);
@@ -547,6 +586,143 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv)
   return res;
 }
 
+void cmCoreTryCompile::LoadResultCache(std::string const& projectFile,
+                                       std::string const& targetName,
+                                       std::vector<std::string> const& sources,
+                                     std::vector<std::string> const& cmakeFlags,
+                                       std::set<std::string> const& langs)
+{
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  // Hash everything that goes into the test project.  Each value is
+  // terminated by a newline so that neighbors cannot run together.
+  cmOStringStream key;
+  key << this->ResultCacheContext << "\n"
+      << cmVersion::GetCMakeVersion() << "\n"
+      << this->Makefile->GetLocalGenerator()->GetGlobalGenerator()->GetName()
+      << "\n"
+      << this->Makefile->GetSafeDefinition("CMAKE_GENERATOR_TOOLSET") << "\n"
+      << this->Makefile->GetSafeDefinition("CMAKE_TRY_COMPILE_CONFIGURATION")
+      << "\n";
+  if(const char* ldflags = cmSystemTools::GetEnv("LDFLAGS"))
+    {
+    key << ldflags;
+    }
+  key << "\n";
+  for(std::set<std::string>::const_iterator li = langs.begin();
+      li != langs.end(); ++li)
+    {
+    static const char* const compilerVars[] =
+      { "_COMPILER", "_COMPILER_ARG1", "_COMPILER_ID", "_COMPILER_VERSION" };
+    for(size_t i = 0; i < sizeof(compilerVars)/sizeof(compilerVars[0]); ++i)
+      {
+      std::string var = "CMAKE_" + *li + compilerVars[i];
+      key << var << "=" << this->Makefile->GetSafeDefinition(var) << "\n";
+      }
+    }
+  for(std::vector<std::string>::const_iterator fi = cmakeFlags.begin();
+      fi != cmakeFlags.end(); ++fi)
+    {
+    key << *fi << "\n";
+    }
+
+  // The generated project names the binary directory and a random
+  // target name, neither of which affects the result.
+  std::string project;
+  {
+  cmsys::ifstream fin(projectFile.c_str(), std::ios::in | std::ios::binary);
+  std::string line;
+  while(cmSystemTools::GetLineFromStream(fin, line))
+    {
+    project += line;
+    project += "\n";
+    }
+  }
+  cmSystemTools::ReplaceString(project, this->BinaryDirectory.c_str(),
+                               "<BINARY_DIR>");
+  cmSystemTools::ReplaceString(project, targetName.c_str(), "<TARGET>");
+  key << project;
+  for(std::vector<std::string>::const_iterator si = sources.begin();
+      si != sources.end(); ++si)
+    {
+    cmCryptoHashMD5 md5;
+    key << md5.HashFile(*si) << "\n";
+    }
+
+  std::string dir =
+    this->Makefile->GetDefinition("CMAKE_TRY_COMPILE_RESULT_CACHE");
+  cmSystemTools::ConvertToUnixSlashes(dir);
+  if(!cmSystemTools::MakeDirectory(dir.c_str()))
+    {
+    return;
+    }
+  cmCryptoHashMD5 md5;
+  this->ResultCacheFile = dir + "/" + md5.HashString(key.str()) + ".txt";
+
+  // Each field is stored as its name on one line followed by the
+  // length of its value, a colon, the value itself and a newline.
+  cmsys::ifstream fin(this->ResultCacheFile.c_str(),
+                      std::ios::in | std::ios::binary);
+  if(!fin)
+    {
+    return;
+    }
+  std::map<std::string, std::string> fields;
+  std::string name;
+  while(std::getline(fin, name))
+    {
+    size_t len;
+    if(!(fin >> len) || fin.get() != ':')
+      {
+      return;
+      }
+    std::string value(len, '\0');
+    if(len > 0 && !fin.read(&value[0], static_cast<std::streamsize>(len)))
+      {
+      return;
+      }
+    if(fin.get() != '\n')
+      {
+      return;
+      }
+    fields[name] = value;
+    }
+  if(fields.find("COMPILE_RESULT") != fields.end() &&
+     fields.find("COMPILE_OUTPUT") != fields.end())
+    {
+    this->ResultCacheFields = fields;
+    this->ResultFromCache = true;
+    }
+#else
+  (void)projectFile;
+  (void)targetName;
+  (void)sources;
+  (void)cmakeFlags;
+  (void)langs;
+#endif
+}
+
+void cmCoreTryCompile::SaveResultCache()
+{
+  if(this->ResultCacheFile.empty() || this->ResultFromCache)
+    {
+    return;
+    }
+  cmOStringStream content;
+  for(std::map<std::string, std::string>::const_iterator
+        fi = this->ResultCacheFields.begin();
+      fi != this->ResultCacheFields.end(); ++fi)
+    {
+    content << fi->first << "\n" << fi->second.size() << ":"
+            << fi->second << "\n";
+    }
+  // Another build tree may store the same entry concurrently.  The
+  // stream replaces the file atomically when it is closed.
+  cmGeneratedFileStream fout;
+  fout.Open(this->ResultCacheFile.c_str(), true, true);
+  fout << content.str();
+  fout.Close();
+}
+
 void cmCoreTryCompile::CleanupFiles(const char* binDir)
 {
   if ( !binDir )
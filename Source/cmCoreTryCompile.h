@@ -46,6 +46,11 @@ public:
    */
   void FindOutputFile(const std::string& targetName);
 
+  /**
+   * Store ResultCacheFields in the try_compile result cache if
+   * TryCompileCode found the call cacheable but had no stored result.
+   */
+  void SaveResultCache();
 
   cmTypeMacro(cmCoreTryCompile, cmCommand);
 
@@ -54,6 +59,24 @@ public:
   std::string FindErrorMessage;
   bool SrcFileSignature;
 
+  // Set before calling TryCompileCode to allow its result to be taken
+  // from the CMAKE_TRY_COMPILE_RESULT_CACHE directory.  It names the
+  // command and anything besides the test project that affects the
+  // result.
+  std::string ResultCacheContext;
+  // The result cache entry for the current call, if any.
+  std::string ResultCacheFile;
+  // Whether TryCompileCode used the stored entry instead of building.
+  bool ResultFromCache;
+  // The fields of the entry, such as COMPILE_RESULT and COMPILE_OUTPUT.
+  std::map<std::string, std::string> ResultCacheFields;
+
+private:
+  void LoadResultCache(std::string const& projectFile,
+                       std::string const& targetName,
+                       std::vector<std::string> const& sources,
+                       std::vector<std::string> const& cmakeFlags,
+                       std::set<std::string> const& langs);
 };
 
 
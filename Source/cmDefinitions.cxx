@@ -114,23 +114,39 @@ cmDefinitions::cmDefinitions(ClosureTag const&, cmDefinitions const* root):
   this->ClosureImpl(undefined, root);
 }
 
+//----------------------------------------------------------------------------
+void cmDefinitions::ResetToClosure(cmDefinitions const& defs)
+{
+  this->Up = 0;
+  this->Map.clear();
+  std::set<std::string> undefined;
+  this->ClosureImpl(undefined, &defs);
+}
+
 //----------------------------------------------------------------------------
 void cmDefinitions::ClosureImpl(std::set<std::string>& undefined,
                                 cmDefinitions const* defs)
 {
+  // The top-most scope stores only defined keys so it can be copied
+  // as a whole if nothing has been collected yet.
+  if(!defs->Up && this->Map.empty() && undefined.empty())
+    {
+    this->Map = defs->Map;
+    return;
+    }
+
   // Consider local definitions.
   for(MapType::const_iterator mi = defs->Map.begin();
       mi != defs->Map.end(); ++mi)
     {
     // Use this key if it is not already set or unset.
-    if(this->Map.find(mi->first) == this->Map.end() &&
-       undefined.find(mi->first) == undefined.end())
+    if(undefined.find(mi->first) == undefined.end())
       {
       if(mi->second.Exists)
         {
         this->Map.insert(*mi);
         }
-      else
+      else if(this->Map.find(mi->first) == this->Map.end())
         {
         undefined.insert(mi->first);
         }
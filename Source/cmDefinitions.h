@@ -13,6 +13,9 @@
 #define cmDefinitions_h
 
 #include "cmStandardIncludes.h"
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+# include <cmsys/hash_map.hxx>
+#endif
 
 /** \class cmDefinitions
  * \brief Store a scope of variable definitions for CMake language.
@@ -47,6 +50,10 @@ public:
       This flattens the scope.  The result has no parent.  */
   cmDefinitions Closure() const;
 
+  /** Reset object to the closure of another scope.  This avoids
+      copying the flattened definitions a second time.  */
+  void ResetToClosure(cmDefinitions const& defs);
+
   /** Compute the set of all defined keys.  */
   std::set<std::string> ClosureKeys() const;
 
@@ -68,8 +75,13 @@ private:
   // Parent scope, if any.
   cmDefinitions* Up;
 
-  // Local definitions, set or unset.
+  // Local definitions, set or unset.  Lookups are done for every
+  // variable reference so use a hash table when available.
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  typedef cmsys::hash_map<std::string, Def> MapType;
+#else
   typedef std::map<std::string, Def> MapType;
+#endif
   MapType Map;
 
   // Internal query and update methods.
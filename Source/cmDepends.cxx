@@ -210,7 +210,14 @@ bool cmDepends::CheckDependencies(std::istream& internalDepends,
       currentDependencies->push_back(dependee);
       }
 
-    if(!cmSystemTools::FileExists(dependee))
+    // Compare the dependee with the depender, or with the depends file
+    // if the depender does not exist.  The comparison fails if the
+    // dependee does not exist, so in the common case each dependee is
+    // looked up only once.
+    int result = 0;
+    bool compared = this->FileComparison->FileTimeCompare(
+      dependerExists? depender : internalDependsFileName, dependee, &result);
+    if(!compared && !cmSystemTools::FileExists(dependee))
       {
       // The dependee does not exist.
       regenerate = true;
@@ -230,9 +237,7 @@ bool cmDepends::CheckDependencies(std::istream& internalDepends,
       if(dependerExists)
         {
         // The dependee and depender both exist.  Compare file times.
-        int result = 0;
-        if((!this->FileComparison->FileTimeCompare(depender, dependee,
-                                              &result) || result < 0))
+        if(!compared || result < 0)
           {
           // The depender is older than the dependee.
           regenerate = true;
@@ -252,9 +257,7 @@ bool cmDepends::CheckDependencies(std::istream& internalDepends,
         {
         // The dependee exists, but the depender doesn't. Regenerate if the
         // internalDepends file is older than the dependee.
-        int result = 0;
-        if((!this->FileComparison->FileTimeCompare(internalDependsFileName,
-                                             dependee, &result) || result < 0))
+        if(!compared || result < 0)
           {
           // The depends-file is older than the dependee.
           regenerate = true;
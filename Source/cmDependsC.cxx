@@ -16,8 +16,13 @@
 #include "cmMakefile.h"
 #include "cmSystemTools.h"
 #include <cmsys/FStream.hxx>
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+# include "cmCryptoHash.h"
+# include <cmsys/Directory.hxx>
+#endif
 
 #include <ctype.h> // isspace
+#include <time.h>
 
 
 #define INCLUDE_REGEX_LINE \
@@ -31,6 +36,7 @@
 //----------------------------------------------------------------------------
 cmDependsC::cmDependsC()
 : ValidDeps(0)
+, SharedCacheLoaded(false)
 {
 }
 
@@ -41,6 +47,7 @@ cmDependsC::cmDependsC(cmLocalGenerator* lg,
                    const std::map<std::string, DependencyVector>* validDeps)
 : cmDepends(lg, targetDir)
 , ValidDeps(validDeps)
+, SharedCacheLoaded(false)
 {
   cmMakefile* mf = lg->GetMakefile();
 
@@ -84,12 +91,14 @@ cmDependsC::cmDependsC(cmLocalGenerator* lg,
   this->CacheFileName += ".includecache";
 
   this->ReadCacheFile();
+  this->SetupSharedCache();
 }
 
 //----------------------------------------------------------------------------
 cmDependsC::~cmDependsC()
 {
   this->WriteCacheFile();
+  this->WriteSharedCacheFile();
 
   for (std::map<std::string, cmIncludeLines*>::iterator it=
          this->FileCache.begin(); it!=this->FileCache.end(); ++it)
@@ -224,15 +233,25 @@ bool cmDependsC::WriteDependencies(const std::set<std::string>& sources,
         scanned.insert(fullName);
 
         // Check whether this file is already in the cache
+        cmIncludeLines* cacheEntry = 0;
         std::map<std::string, cmIncludeLines*>::iterator fileIt=
           this->FileCache.find(fullName);
         if (fileIt!=this->FileCache.end())
           {
-          fileIt->second->Used=true;
+          cacheEntry = fileIt->second;
+          }
+        else if(srcFiles <= 0)
+          {
+          // Another target may have scanned this header already.
+          cacheEntry = this->FindSharedCacheEntry(fullName);
+          }
+        if (cacheEntry)
+          {
+          cacheEntry->Used=true;
           dependencies.insert(fullName);
           for (std::vector<UnscannedEntry>::const_iterator incIt=
-                fileIt->second->UnscannedEntries.begin();
-              incIt!=fileIt->second->UnscannedEntries.end(); ++incIt)
+                cacheEntry->UnscannedEntries.begin();
+              incIt!=cacheEntry->UnscannedEntries.end(); ++incIt)
             {
             if (this->Encountered.find(incIt->FileName) ==
                 this->Encountered.end())
@@ -246,7 +265,10 @@ bool cmDependsC::WriteDependencies(const std::set<std::string>& sources,
           {
 
           // Try to scan the file.  Just leave it out if we cannot find
-          // it.
+          // it.  Take the file time and size before reading so that a
+          // concurrent change cannot be recorded with the old content.
+          long mtime = cmSystemTools::ModifiedTime(fullName.c_str());
+          unsigned long size = cmSystemTools::FileLength(fullName.c_str());
           cmsys::ifstream fin(fullName.c_str());
           if(fin)
             {
@@ -257,6 +279,12 @@ bool cmDependsC::WriteDependencies(const std::set<std::string>& sources,
             // containing the file to handle double-quote includes.
             std::string dir = cmSystemTools::GetFilenamePath(fullName);
             this->Scan(fin, dir.c_str(), fullName);
+            // Share headers with other targets.  Sources are rarely
+            // used by more than one target.
+            if(srcFiles <= 0)
+              {
+              this->AddSharedCacheEntry(fullName, mtime, size);
+              }
             }
           }
         }
@@ -419,6 +447,268 @@ void cmDependsC::WriteCacheFile() const
    }
 }
 
+//----------------------------------------------------------------------------
+void cmDependsC::SetupSharedCache()
+{
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  // What a scan records depends only on the expressions selecting
+  // include lines, so all targets and languages that use the same
+  // expressions share one database.
+  std::string key = this->IncludeRegexLineString;
+  key += "\n";
+  key += this->IncludeRegexScanString;
+  key += "\n";
+  key += this->IncludeRegexTransformString;
+  cmCryptoHashMD5 md5;
+  this->SharedCacheFileName =
+    this->LocalGenerator->GetMakefile()->GetHomeOutputDirectory();
+  this->SharedCacheFileName += cmake::GetCMakeFilesDirectory();
+  this->SharedCacheFileName += "/cmake.includescan.";
+  this->SharedCacheFileName += md5.HashString(key);
+#endif
+}
+
+//----------------------------------------------------------------------------
+void cmDependsC::ClearSharedCache(std::string const& dir)
+{
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  // Remove the databases of all include expressions, including those
+  // no longer used by any target.
+  cmsys::Directory d;
+  if(!d.Load(dir.c_str()))
+    {
+    return;
+    }
+  for(unsigned long i = 0; i < d.GetNumberOfFiles(); ++i)
+    {
+    std::string name = d.GetFile(i);
+    if(cmHasLiteralPrefix(name, "cmake.includescan."))
+      {
+      std::string path = dir + "/" + name;
+      cmSystemTools::RemoveFile(path.c_str());
+      }
+    }
+#else
+  (void)dir;
+#endif
+}
+
+//----------------------------------------------------------------------------
+cmDependsC::cmIncludeLines*
+cmDependsC::FindSharedCacheEntry(std::string const& fullName)
+{
+  if(this->SharedCacheFileName.empty())
+    {
+    return 0;
+    }
+
+  // Most runs find everything in the per-target cache.  Read the
+  // database only when it is needed.
+  if(!this->SharedCacheLoaded)
+    {
+    this->SharedCacheLoaded = true;
+    this->ReadSharedCacheFile(this->SharedCache);
+    }
+  SharedCacheType::const_iterator i = this->SharedCache.find(fullName);
+  if(i == this->SharedCache.end())
+    {
+    return 0;
+    }
+  if(i->second.Time != cmSystemTools::ModifiedTime(fullName.c_str()) ||
+     i->second.Size != cmSystemTools::FileLength(fullName.c_str()))
+    {
+    // Drop the entry from the database when writing it unless the
+    // file is scanned again and stored anew.
+    this->SharedCacheStale.insert(fullName);
+    return 0;
+    }
+  cmIncludeLines* cacheEntry = new cmIncludeLines;
+  cacheEntry->UnscannedEntries = i->second.UnscannedEntries;
+  this->FileCache[fullName] = cacheEntry;
+  return cacheEntry;
+}
+
+//----------------------------------------------------------------------------
+void cmDependsC::AddSharedCacheEntry(std::string const& fullName,
+                                     long mtime, unsigned long size)
+{
+  // A file modified within the current second may change again
+  // without a visible change of its modification time.
+  if(this->SharedCacheFileName.empty() ||
+     mtime == 0 || mtime >= static_cast<long>(time(0)))
+    {
+    return;
+    }
+  cmSharedIncludeLines& entry = this->SharedCacheAdditions[fullName];
+  entry.Time = mtime;
+  entry.Size = size;
+  entry.UnscannedEntries = this->FileCache[fullName]->UnscannedEntries;
+}
+
+//----------------------------------------------------------------------------
+bool cmDependsC::ReadSharedCacheFile(SharedCacheType& cache) const
+{
+  cmsys::ifstream fin(this->SharedCacheFileName.c_str());
+  if(!fin)
+    {
+    return false;
+    }
+
+  // Each entry is the file name, a line with its modification time
+  // and size, and pairs of lines for its includes, ended by an empty
+  // line.  Drop the entry being read if the file was cut short.
+  std::string line;
+  while(cmSystemTools::GetLineFromStream(fin, line))
+    {
+    if(line.empty())
+      {
+      continue;
+      }
+    std::string fileName = line;
+    cmSharedIncludeLines entry;
+    if(!cmSystemTools::GetLineFromStream(fin, line) ||
+       sscanf(line.c_str(), "%ld %lu", &entry.Time, &entry.Size) != 2)
+      {
+      return false;
+      }
+    bool complete = false;
+    while(cmSystemTools::GetLineFromStream(fin, line))
+      {
+      if(line.empty())
+        {
+        complete = true;
+        break;
+        }
+      UnscannedEntry include;
+      include.FileName = line;
+      if(!cmSystemTools::GetLineFromStream(fin, line))
+        {
+        break;
+        }
+      if(line != "-")
+        {
+        include.QuotedLocation = line;
+        }
+      entry.UnscannedEntries.push_back(include);
+      }
+    if(!complete)
+      {
+      return false;
+      }
+    cache[fileName] = entry;
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void cmDependsC::WriteSharedCacheFile()
+{
+  if(this->SharedCacheAdditions.empty() && this->SharedCacheStale.empty())
+    {
+    return;
+    }
+
+  // Other "make -j" jobs may have stored entries since we read the
+  // database.  Merge with its current content and replace the file
+  // atomically.  Entries lost to a concurrent writer are scanned
+  // again later.  Entries found out of date while scanning are
+  // dropped.  Entries of removed files go away with the whole database
+  // when the dependency information is cleared.
+  SharedCacheType cache;
+  this->ReadSharedCacheFile(cache);
+  for(std::set<std::string>::const_iterator i =
+        this->SharedCacheStale.begin();
+      i != this->SharedCacheStale.end(); ++i)
+    {
+    cache.erase(*i);
+    }
+  for(SharedCacheType::const_iterator i = this->SharedCacheAdditions.begin();
+      i != this->SharedCacheAdditions.end(); ++i)
+    {
+    cache[i->first] = i->second;
+    }
+
+  char suffix[64];
+  sprintf(suffix, ".tmp%u", cmSystemTools::RandomSeed());
+  std::string tempName = this->SharedCacheFileName + suffix;
+  {
+  cmsys::ofstream fout(tempName.c_str());
+  if(!fout)
+    {
+    return;
+    }
+  for(SharedCacheType::const_iterator i = cache.begin();
+      i != cache.end(); ++i)
+    {
+    fout << i->first << "\n" << i->second.Time << " " << i->second.Size
+         << "\n";
+    for(std::vector<UnscannedEntry>::const_iterator
+          incIt = i->second.UnscannedEntries.begin();
+        incIt != i->second.UnscannedEntries.end(); ++incIt)
+      {
+      fout << incIt->FileName << "\n"
+           << (incIt->QuotedLocation.empty()? "-" : incIt->QuotedLocation)
+           << "\n";
+      }
+    fout << "\n";
+    }
+  if(!fout)
+    {
+    fout.close();
+    cmSystemTools::RemoveFile(tempName.c_str());
+    return;
+    }
+  }
+  if(!cmSystemTools::RenameFile(tempName.c_str(),
+                                this->SharedCacheFileName.c_str()))
+    {
+    cmSystemTools::RemoveFile(tempName.c_str());
+    }
+}
+
+//----------------------------------------------------------------------------
+// Find the next line in [pos,end) whose first character other than a
+// space or tab is '#'.  Only such lines can match the include and
+// transform expressions.  The position must be the start of a line.
+static bool cmDependsCNextDirective(const char*& pos, const char* end,
+                                    std::string& line)
+{
+  while(pos < end)
+    {
+    const char* hash =
+      static_cast<const char*>(memchr(pos, '#', static_cast<size_t>(end-pos)));
+    if(!hash)
+      {
+      pos = end;
+      return false;
+      }
+    const char* lineBegin = hash;
+    while(lineBegin > pos && (lineBegin[-1] == ' ' || lineBegin[-1] == '\t'))
+      {
+      --lineBegin;
+      }
+    bool directive = (lineBegin == pos || lineBegin[-1] == '\n');
+    const char* lineEnd =
+      static_cast<const char*>(memchr(hash, '\n',
+                                      static_cast<size_t>(end-hash)));
+    if(!lineEnd)
+      {
+      lineEnd = end;
+      }
+    pos = lineEnd < end ? lineEnd + 1 : end;
+    if(directive)
+      {
+      if(lineEnd > lineBegin && lineEnd[-1] == '\r')
+        {
+        --lineEnd;
+        }
+      line.assign(lineBegin, lineEnd);
+      return true;
+      }
+    }
+  return false;
+}
+
 //----------------------------------------------------------------------------
 void cmDependsC::Scan(std::istream& is, const char* directory,
   const std::string& fullName)
@@ -427,53 +717,85 @@ void cmDependsC::Scan(std::istream& is, const char* directory,
   newCacheEntry->Used=true;
   this->FileCache[fullName]=newCacheEntry;
 
-  // Read one line at a time.
+  // Read blocks of complete lines and look only at lines that may be
+  // directives instead of matching every line against the expressions.
+  std::vector<char> buffer;
   std::string line;
-  while(cmSystemTools::GetLineFromStream(is, line))
+  bool done = false;
+  while(!done)
     {
-    // Transform the line content first.
-    if(!this->TransformRules.empty())
+    size_t const blockSize = 65536;
+    size_t have = buffer.size();
+    buffer.resize(have + blockSize);
+    is.read(&buffer[have], static_cast<std::streamsize>(blockSize));
+    buffer.resize(have + static_cast<size_t>(is.gcount()));
+    done = !is;
+    if(buffer.empty())
       {
-      this->TransformLine(line);
+      continue;
       }
-
-    // Match include directives.
-    if(this->IncludeRegexLine.find(line.c_str()))
+    const char* pos = &buffer[0];
+    const char* end = pos + buffer.size();
+    if(!done)
       {
-      // Get the file being included.
-      UnscannedEntry entry;
-      entry.FileName = this->IncludeRegexLine.match(2);
-      cmSystemTools::ConvertToUnixSlashes(entry.FileName);
-      if(this->IncludeRegexLine.match(3) == "\"" &&
-         !cmSystemTools::FileIsFullPath(entry.FileName.c_str()))
+      // Leave a partial last line for the next block.
+      while(end > pos && end[-1] != '\n')
         {
-        // This was a double-quoted include with a relative path.  We
-        // must check for the file in the directory containing the
-        // file we are scanning.
-        entry.QuotedLocation =
-          cmSystemTools::CollapseCombinedPath(directory, entry.FileName);
+        --end;
+        }
+      if(end == pos)
+        {
+        continue;
+        }
+      }
+    size_t used = static_cast<size_t>(end - pos);
+    while(cmDependsCNextDirective(pos, end, line))
+      {
+      // Transform the line content first.
+      if(!this->TransformRules.empty())
+        {
+        this->TransformLine(line);
         }
 
-      // Queue the file if it has not yet been encountered and it
-      // matches the regular expression for recursive scanning.  Note
-      // that this check does not account for the possibility of two
-      // headers with the same name in different directories when one
-      // is included by double-quotes and the other by angle brackets.
-      // It also does not work properly if two header files with the same
-      // name exist in different directories, and both are included from a
-      // file their own directory by simply using "filename.h" (#12619)
-      // This kind of problem will be fixed when a more
-      // preprocessor-like implementation of this scanner is created.
-      if (this->IncludeRegexScan.find(entry.FileName.c_str()))
+      // Match include directives.
+      if(this->IncludeRegexLine.find(line.c_str()))
         {
-        newCacheEntry->UnscannedEntries.push_back(entry);
-        if(this->Encountered.find(entry.FileName) == this->Encountered.end())
+        // Get the file being included.
+        UnscannedEntry entry;
+        entry.FileName = this->IncludeRegexLine.match(2);
+        cmSystemTools::ConvertToUnixSlashes(entry.FileName);
+        if(this->IncludeRegexLine.match(3) == "\"" &&
+           !cmSystemTools::FileIsFullPath(entry.FileName.c_str()))
           {
-          this->Encountered.insert(entry.FileName);
-          this->Unscanned.push(entry);
+          // This was a double-quoted include with a relative path.  We
+          // must check for the file in the directory containing the
+          // file we are scanning.
+          entry.QuotedLocation =
+            cmSystemTools::CollapseCombinedPath(directory, entry.FileName);
+          }
+
+        // Queue the file if it has not yet been encountered and it
+        // matches the regular expression for recursive scanning.  Note
+        // that this check does not account for the possibility of two
+        // headers with the same name in different directories when one
+        // is included by double-quotes and the other by angle brackets.
+        // It also does not work properly if two header files with the same
+        // name exist in different directories, and both are included from a
+        // file their own directory by simply using "filename.h" (#12619)
+        // This kind of problem will be fixed when a more
+        // preprocessor-like implementation of this scanner is created.
+        if (this->IncludeRegexScan.find(entry.FileName.c_str()))
+          {
+          newCacheEntry->UnscannedEntries.push_back(entry);
+          if(this->Encountered.find(entry.FileName) == this->Encountered.end())
+            {
+            this->Encountered.insert(entry.FileName);
+            this->Unscanned.push(entry);
+            }
           }
         }
       }
+    buffer.erase(buffer.begin(), buffer.begin() + used);
     }
 }
 
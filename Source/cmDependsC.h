@@ -32,6 +32,10 @@ public:
   /** Virtual destructor to cleanup subclasses properly.  */
   virtual ~cmDependsC();
 
+  /** Remove the include scan results shared by the targets of a build
+      tree, given its CMakeFiles directory.  */
+  static void ClearSharedCache(std::string const& dir);
+
 protected:
   // Implement writing/checking methods required by superclass.
   virtual bool WriteDependencies(const std::set<std::string>& sources,
@@ -89,6 +93,29 @@ protected:
 
   void WriteCacheFile() const;
   void ReadCacheFile();
+
+  // Scan results shared by all targets in the build tree.  Entries are
+  // valid while the modification time and size of the file match.
+  struct cmSharedIncludeLines
+  {
+    cmSharedIncludeLines(): Time(0), Size(0) {}
+    long Time;
+    unsigned long Size;
+    std::vector<UnscannedEntry> UnscannedEntries;
+  };
+  typedef std::map<std::string, cmSharedIncludeLines> SharedCacheType;
+  std::string SharedCacheFileName;
+  bool SharedCacheLoaded;
+  SharedCacheType SharedCache;
+  SharedCacheType SharedCacheAdditions;
+  std::set<std::string> SharedCacheStale;
+
+  void SetupSharedCache();
+  bool ReadSharedCacheFile(SharedCacheType& cache) const;
+  void WriteSharedCacheFile();
+  cmIncludeLines* FindSharedCacheEntry(std::string const& fullName);
+  void AddSharedCacheEntry(std::string const& fullName,
+                           long mtime, unsigned long size);
 private:
   cmDependsC(cmDependsC const&); // Purposely not implemented.
   void operator=(cmDependsC const&); // Purposely not implemented.
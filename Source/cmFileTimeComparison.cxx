@@ -32,11 +32,17 @@
 class cmFileTimeComparisonInternal
 {
 public:
+  cmFileTimeComparisonInternal(): Lookups(0), Queries(0) {}
+
   // Internal comparison method.
   inline bool FileTimeCompare(const char* f1, const char* f2, int* result);
 
   bool FileTimesDiffer(const char* f1, const char* f2);
 
+  // Number of lookups made and of those that reached the file system.
+  unsigned long Lookups;
+  unsigned long Queries;
+
 private:
 #if defined(CMAKE_BUILD_WITH_CMAKE)
   // Use a hash table to efficiently map from file name to modification time.
@@ -66,6 +72,7 @@ private:
 bool cmFileTimeComparisonInternal::Stat(const char* fname,
                                         cmFileTimeComparison_Type* st)
 {
+  ++this->Lookups;
 #if defined(CMAKE_BUILD_WITH_CMAKE)
   // Use the stored time if available.
   cmFileTimeComparisonInternal::FileStatsMap::iterator fit =
@@ -77,6 +84,7 @@ bool cmFileTimeComparisonInternal::Stat(const char* fname,
     }
 #endif
 
+  ++this->Queries;
 #if !defined(_WIN32) || defined(__CYGWIN__)
   // POSIX version.  Use the stat function.
   int res = ::stat(fname, st);
@@ -131,6 +139,18 @@ bool cmFileTimeComparison::FileTimesDiffer(const char* f1, const char* f2)
   return this->Internals->FileTimesDiffer(f1, f2);
 }
 
+//----------------------------------------------------------------------------
+unsigned long cmFileTimeComparison::GetNumberOfLookups() const
+{
+  return this->Internals->Lookups;
+}
+
+//----------------------------------------------------------------------------
+unsigned long cmFileTimeComparison::GetNumberOfQueries() const
+{
+  return this->Internals->Queries;
+}
+
 //----------------------------------------------------------------------------
 int cmFileTimeComparisonInternal::Compare(cmFileTimeComparison_Type* s1,
                                           cmFileTimeComparison_Type* s2)
@@ -41,6 +41,14 @@ public:
    */
   bool FileTimesDiffer(const char* f1, const char* f2);
 
+  /**
+   *  Get the number of file time lookups made so far and how many of
+   *  them had to query the file system because the time was not
+   *  already known.
+   */
+  unsigned long GetNumberOfLookups() const;
+  unsigned long GetNumberOfQueries() const;
+
 protected:
 
   cmFileTimeComparisonInternal* Internals;
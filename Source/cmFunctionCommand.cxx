@@ -13,14 +13,37 @@
 
 #include "cmake.h"
 
+// The recorded definition of a function.  It is shared by the command
+// and all of its clones so that invoking the function does not copy it.
+class cmFunctionHelperDefinition
+{
+public:
+  cmFunctionHelperDefinition(): ReferenceCount(1) {}
+  void Register() { ++this->ReferenceCount; }
+  void UnRegister()
+    {
+    if(--this->ReferenceCount == 0)
+      {
+      delete this;
+      }
+    }
+
+  std::vector<std::string> Args;
+  std::vector<cmListFileFunction> Functions;
+  cmPolicies::PolicyMap Policies;
+private:
+  unsigned int ReferenceCount;
+};
+
 // define the class for function commands
 class cmFunctionHelperCommand : public cmCommand
 {
 public:
-  cmFunctionHelperCommand() {}
+  cmFunctionHelperCommand(cmFunctionHelperDefinition* def):
+    Definition(def) {}
 
   ///! clean up any memory allocated by the function
-  ~cmFunctionHelperCommand() {}
+  ~cmFunctionHelperCommand() { this->Definition->UnRegister(); }
 
   /**
    * This is used to avoid including this command
@@ -38,12 +61,9 @@ public:
    */
   virtual cmCommand* Clone()
   {
-    cmFunctionHelperCommand *newC = new cmFunctionHelperCommand;
-    // we must copy when we clone
-    newC->Args = this->Args;
-    newC->Functions = this->Functions;
-    newC->Policies = this->Policies;
-    return newC;
+    // The definition is not modified by invocations so share it.
+    this->Definition->Register();
+    return new cmFunctionHelperCommand(this->Definition);
   }
 
   /**
@@ -64,13 +84,12 @@ public:
   /**
    * The name of the command as specified in CMakeList.txt.
    */
-  virtual std::string GetName() const { return this->Args[0]; }
+  virtual std::string GetName() const
+    { return this->Definition->Args[0]; }
 
   cmTypeMacro(cmFunctionHelperCommand, cmCommand);
 
-  std::vector<std::string> Args;
-  std::vector<cmListFileFunction> Functions;
-  cmPolicies::PolicyMap Policies;
+  cmFunctionHelperDefinition* Definition;
 };
 
 
@@ -78,17 +97,21 @@ bool cmFunctionHelperCommand::InvokeInitialPass
 (const std::vector<cmListFileArgument>& args,
  cmExecutionStatus & inStatus)
 {
+  std::vector<std::string> const& fargs = this->Definition->Args;
+  std::vector<cmListFileFunction> const& functions =
+    this->Definition->Functions;
+
   // Expand the argument list to the function.
   std::vector<std::string> expandedArgs;
   this->Makefile->ExpandArguments(args, expandedArgs);
 
   // make sure the number of arguments passed is at least the number
   // required by the signature
-  if (expandedArgs.size() < this->Args.size() - 1)
+  if (expandedArgs.size() < fargs.size() - 1)
     {
     std::string errorMsg =
       "Function invoked with incorrect arguments for function named: ";
-    errorMsg += this->Args[0];
+    errorMsg += fargs[0];
     this->SetError(errorMsg);
     return false;
     }
@@ -100,7 +123,8 @@ bool cmFunctionHelperCommand::InvokeInitialPass
 
   // Push a weak policy scope which restores the policies recorded at
   // function creation.
-  cmMakefile::PolicyPushPop polScope(this->Makefile, true, this->Policies);
+  cmMakefile::PolicyPushPop polScope(this->Makefile, true,
+                                     this->Definition->Policies);
 
   // set the value of argc
   cmOStringStream strStream;
@@ -119,9 +143,9 @@ bool cmFunctionHelperCommand::InvokeInitialPass
     }
 
   // define the formal arguments
-  for (unsigned int j = 1; j < this->Args.size(); ++j)
+  for (unsigned int j = 1; j < fargs.size(); ++j)
     {
-    this->Makefile->AddDefinition(this->Args[j],
+    this->Makefile->AddDefinition(fargs[j],
                                   expandedArgs[j-1].c_str());
     }
 
@@ -137,7 +161,7 @@ bool cmFunctionHelperCommand::InvokeInitialPass
       argvDef += ";";
       }
     argvDef += *eit;
-    if ( cnt >= this->Args.size()-1 )
+    if ( cnt >= fargs.size()-1 )
       {
       if ( argnDef.size() > 0 )
         {
@@ -154,10 +178,10 @@ bool cmFunctionHelperCommand::InvokeInitialPass
 
   // Invoke all the functions that were collected in the block.
   // for each function
-  for(unsigned int c = 0; c < this->Functions.size(); ++c)
+  for(unsigned int c = 0; c < functions.size(); ++c)
     {
     cmExecutionStatus status;
-    if (!this->Makefile->ExecuteCommand(this->Functions[c],status) ||
+    if (!this->Makefile->ExecuteCommand(functions[c],status) ||
         status.GetNestedError())
       {
       // The error message should have already included the call stack
@@ -202,7 +226,7 @@ IsFunctionBlocked(const cmListFileFunction& lff, cmMakefile &mf,
       name += " )";
 
       // create a new command and add it to cmake
-      cmFunctionHelperCommand *f = new cmFunctionHelperCommand();
+      cmFunctionHelperDefinition *f = new cmFunctionHelperDefinition();
       f->Args = this->Args;
       f->Functions = this->Functions;
       mf.RecordPolicies(f->Policies);
@@ -221,7 +245,7 @@ IsFunctionBlocked(const cmListFileFunction& lff, cmMakefile &mf,
       std::string newName = "_" + this->Args[0];
       mf.GetCMakeInstance()->RenameCommand(this->Args[0],
                                            newName);
-      mf.AddCommand(f);
+      mf.AddCommand(new cmFunctionHelperCommand(f));
 
       // remove the function blocker now that the function is defined
       mf.RemoveFunctionBlocker(this, lff);
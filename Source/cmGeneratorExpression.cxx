@@ -12,6 +12,8 @@
 #include "cmGeneratorExpression.h"
 
 #include "cmMakefile.h"
+#include "cmLocalGenerator.h"
+#include "cmGlobalGenerator.h"
 #include "cmTarget.h"
 #include "assert.h"
 
@@ -76,12 +78,32 @@ const char *cmCompiledGeneratorExpression::Evaluate(
     return this->Input.c_str();
     }
 
+  if (!currentTarget)
+    {
+    currentTarget = headTarget;
+    }
+  if (this->OutputReusable && !dagChecker
+      && mf == this->ReusableMakefile
+      && headTarget == this->ReusableHeadTarget
+      && currentTarget == this->ReusableCurrentTarget
+      && config == this->ReusableConfig)
+    {
+    return this->Output.c_str();
+    }
+
+  if (!this->Tree)
+    {
+    this->ParseInput(mf);
+    }
+
   this->Output = "";
 
+  std::vector<cmGeneratorExpressionEvaluator*> const& evaluators =
+                                                  this->Tree->GetEvaluators();
   std::vector<cmGeneratorExpressionEvaluator*>::const_iterator it
-                                                  = this->Evaluators.begin();
+                                                  = evaluators.begin();
   const std::vector<cmGeneratorExpressionEvaluator*>::const_iterator end
-                                                  = this->Evaluators.end();
+                                                  = evaluators.end();
 
   cmGeneratorExpressionContext context;
   context.Makefile = mf;
@@ -91,7 +113,7 @@ const char *cmCompiledGeneratorExpression::Evaluate(
   context.HadContextSensitiveCondition = false;
   context.HeadTarget = headTarget;
   context.EvaluateForBuildsystem = this->EvaluateForBuildsystem;
-  context.CurrentTarget = currentTarget ? currentTarget : headTarget;
+  context.CurrentTarget = currentTarget;
   context.Backtrace = this->Backtrace;
 
   for ( ; it != end; ++it)
@@ -117,42 +139,99 @@ const char *cmCompiledGeneratorExpression::Evaluate(
 
   this->DependTargets = context.DependTargets;
   this->AllTargetsSeen = context.AllTargets;
+
+  // The result of an expression that looked at no target, no
+  // context-sensitive condition and no DAG checker is the same the next
+  // time it is evaluated in the same makefile and configuration, whose
+  // state is final once the build system is being generated.
+  this->OutputReusable = !dagChecker && !context.HadError
+                      && !context.HadContextSensitiveCondition
+                      && context.DependTargets.empty()
+                      && context.AllTargets.empty()
+                      && context.SeenTargetProperties.empty()
+                      && mf && mf->IsGeneratingBuildSystem();
+  this->ReusableMakefile = mf;
+  this->ReusableConfig = config;
+  this->ReusableHeadTarget = headTarget;
+  this->ReusableCurrentTarget = currentTarget;
   // TODO: Return a std::string from here instead?
   return this->Output.c_str();
 }
 
-cmCompiledGeneratorExpression::cmCompiledGeneratorExpression(
-              cmListFileBacktrace const& backtrace,
-              const std::string& input)
-  : Backtrace(backtrace), Input(input),
-    HadContextSensitiveCondition(false),
-    EvaluateForBuildsystem(false)
+//----------------------------------------------------------------------------
+cmGeneratorExpressionParseTree
+::cmGeneratorExpressionParseTree(std::string const& input)
+  : Input(input), References(1)
 {
   cmGeneratorExpressionLexer l;
-  std::vector<cmGeneratorExpressionToken> tokens =
-                                              l.Tokenize(this->Input);
-  this->NeedsEvaluation = l.GetSawGeneratorExpression();
+  std::vector<cmGeneratorExpressionToken> tokens = l.Tokenize(this->Input);
+  cmGeneratorExpressionParser p(tokens);
+  p.Parse(this->Evaluators);
+}
+
+//----------------------------------------------------------------------------
+cmGeneratorExpressionParseTree::~cmGeneratorExpressionParseTree()
+{
+  std::vector<cmGeneratorExpressionEvaluator*>::iterator it
+                                                  = this->Evaluators.begin();
+  const std::vector<cmGeneratorExpressionEvaluator*>::iterator end
+                                                  = this->Evaluators.end();
+
+  for ( ; it != end; ++it)
+    {
+    delete *it;
+    }
+}
 
-  if (this->NeedsEvaluation)
+//----------------------------------------------------------------------------
+void cmGeneratorExpressionParseTree::Release()
+{
+  if (--this->References == 0)
     {
-    cmGeneratorExpressionParser p(tokens);
-    p.Parse(this->Evaluators);
+    delete this;
     }
 }
 
+//----------------------------------------------------------------------------
+cmCompiledGeneratorExpression::cmCompiledGeneratorExpression(
+              cmListFileBacktrace const& backtrace,
+              const std::string& input)
+  : Backtrace(backtrace), Tree(0), Input(input),
+    HadContextSensitiveCondition(false),
+    EvaluateForBuildsystem(false),
+    OutputReusable(false), ReusableMakefile(0),
+    ReusableHeadTarget(0), ReusableCurrentTarget(0)
+{
+  this->NeedsEvaluation =
+    cmGeneratorExpression::Find(this->Input) != std::string::npos;
+}
 
 //----------------------------------------------------------------------------
 cmCompiledGeneratorExpression::~cmCompiledGeneratorExpression()
 {
-  std::vector<cmGeneratorExpressionEvaluator*>::const_iterator it
-                                                  = this->Evaluators.begin();
-  const std::vector<cmGeneratorExpressionEvaluator*>::const_iterator end
-                                                  = this->Evaluators.end();
+  if (this->Tree)
+    {
+    this->Tree->Release();
+    }
+}
 
-  for ( ; it != end; ++it)
+//----------------------------------------------------------------------------
+void cmCompiledGeneratorExpression::ParseInput(cmMakefile* mf) const
+{
+  if (mf && mf->IsGeneratingBuildSystem())
     {
-    delete *it;
+    // Expressions with the same input, such as those generated for
+    // the usage requirements of each dependency, share a parse tree
+    // while generating.
+    this->Tree = mf->GetLocalGenerator()->GetGlobalGenerator()
+                                ->GetGeneratorExpressionParseTree(this->Input);
+    }
+  else
+    {
+    this->Tree = new cmGeneratorExpressionParseTree(this->Input);
     }
+  // The tree holds the input from now on.
+  std::string().swap(this->Input);
 }
 
 //----------------------------------------------------------------------------
@@ -28,6 +28,36 @@ struct cmGeneratorExpressionDAGChecker;
 
 class cmCompiledGeneratorExpression;
 
+/** \class cmGeneratorExpressionParseTree
+ * \brief The evaluators parsed from one generator expression input.
+ *
+ * While generating, compiled expressions with the same input share one
+ * tree from cmGlobalGenerator.  A tree is deleted when the last
+ * expression using it and the generator have released it.
+ */
+class cmGeneratorExpressionParseTree
+{
+public:
+  cmGeneratorExpressionParseTree(std::string const& input);
+
+  std::string const& GetInput() const { return this->Input; }
+  std::vector<cmGeneratorExpressionEvaluator*> const& GetEvaluators() const
+    { return this->Evaluators; }
+
+  void Retain() { ++this->References; }
+  void Release();
+
+private:
+  ~cmGeneratorExpressionParseTree();
+  cmGeneratorExpressionParseTree(const cmGeneratorExpressionParseTree &);
+  void operator=(const cmGeneratorExpressionParseTree &);
+
+  // The evaluators refer to the text of the input.
+  const std::string Input;
+  std::vector<cmGeneratorExpressionEvaluator*> Evaluators;
+  unsigned int References;
+};
+
 /** \class cmGeneratorExpression
  * \brief Evaluate generate-time query expression syntax.
  *
@@ -100,7 +130,7 @@ public:
 
   std::string const& GetInput() const
   {
-    return this->Input;
+    return this->Tree ? this->Tree->GetInput() : this->Input;
   }
 
   cmListFileBacktrace GetBacktrace() const
@@ -115,6 +145,7 @@ public:
   void SetEvaluateForBuildsystem(bool eval)
   {
     this->EvaluateForBuildsystem = eval;
+    this->OutputReusable = false;
   }
 
 private:
@@ -126,9 +157,12 @@ private:
   cmCompiledGeneratorExpression(const cmCompiledGeneratorExpression &);
   void operator=(const cmCompiledGeneratorExpression &);
 
+  void ParseInput(cmMakefile* mf) const;
+
   cmListFileBacktrace Backtrace;
-  std::vector<cmGeneratorExpressionEvaluator*> Evaluators;
-  const std::string Input;
+  // Parsed on first evaluation, after which the tree holds the input.
+  mutable cmGeneratorExpressionParseTree* Tree;
+  mutable std::string Input;
   bool NeedsEvaluation;
 
   mutable std::set<cmTarget*> DependTargets;
@@ -137,6 +171,14 @@ private:
   mutable std::string Output;
   mutable bool HadContextSensitiveCondition;
   bool EvaluateForBuildsystem;
+
+  // Whether Output may be returned again for evaluations with the
+  // same makefile, configuration and targets.
+  mutable bool OutputReusable;
+  mutable cmMakefile* ReusableMakefile;
+  mutable std::string ReusableConfig;
+  mutable cmTarget const* ReusableHeadTarget;
+  mutable cmTarget const* ReusableCurrentTarget;
 };
 
 #endif
@@ -21,17 +21,14 @@ cmGeneratorExpressionDAGChecker::cmGeneratorExpressionDAGChecker(
                 const std::string &property,
                 const GeneratorExpressionContent *content,
                 cmGeneratorExpressionDAGChecker *parent)
-  : Parent(parent), Target(target), Property(property),
+  : Parent(parent), Top(parent ? parent->Top : this),
+    Target(target), Property(property),
     Content(content), Backtrace(backtrace), TransitivePropertiesOnly(false)
 {
-  const cmGeneratorExpressionDAGChecker *top = this;
-  const cmGeneratorExpressionDAGChecker *p = this->Parent;
-  while (p)
-    {
-    top = p;
-    p = p->Parent;
-    }
+  const cmGeneratorExpressionDAGChecker *top = this->Top;
   this->CheckResult = this->CheckGraph();
+  const_cast<cmGeneratorExpressionDAGChecker *>(top)
+                                          ->Active[target].insert(property);
 
 #define TEST_TRANSITIVE_PROPERTY_METHOD(METHOD) \
   top->METHOD () ||
@@ -59,6 +56,15 @@ cmGeneratorExpressionDAGChecker::cmGeneratorExpressionDAGChecker(
     }
 }
 
+//----------------------------------------------------------------------------
+cmGeneratorExpressionDAGChecker::~cmGeneratorExpressionDAGChecker()
+{
+  std::multiset<std::string>& properties =
+    const_cast<cmGeneratorExpressionDAGChecker *>(this->Top)
+                                                    ->Active[this->Target];
+  properties.erase(properties.find(this->Property));
+}
+
 //----------------------------------------------------------------------------
 cmGeneratorExpressionDAGChecker::Result
 cmGeneratorExpressionDAGChecker::Check() const
@@ -127,43 +133,30 @@ void cmGeneratorExpressionDAGChecker::ReportError(
 cmGeneratorExpressionDAGChecker::Result
 cmGeneratorExpressionDAGChecker::CheckGraph() const
 {
-  const cmGeneratorExpressionDAGChecker *parent = this->Parent;
-  while (parent)
+  // Look for this target and property among the checkers this one is
+  // nested in without walking the chain.
+  std::map<std::string, std::multiset<std::string> >::const_iterator it =
+                                          this->Top->Active.find(this->Target);
+  if (it == this->Top->Active.end()
+      || it->second.find(this->Property) == it->second.end())
     {
-    if (this->Target == parent->Target && this->Property == parent->Property)
-      {
-      return (parent == this->Parent) ? SELF_REFERENCE : CYCLIC_REFERENCE;
-      }
-    parent = parent->Parent;
+    return DAG;
     }
-  return DAG;
+  return (this->Target == this->Parent->Target
+          && this->Property == this->Parent->Property)
+          ? SELF_REFERENCE : CYCLIC_REFERENCE;
 }
 
 //----------------------------------------------------------------------------
 bool cmGeneratorExpressionDAGChecker::GetTransitivePropertiesOnly()
 {
-  const cmGeneratorExpressionDAGChecker *top = this;
-  const cmGeneratorExpressionDAGChecker *parent = this->Parent;
-  while (parent)
-    {
-    top = parent;
-    parent = parent->Parent;
-    }
-
-  return top->TransitivePropertiesOnly;
+  return this->Top->TransitivePropertiesOnly;
 }
 
 //----------------------------------------------------------------------------
 bool cmGeneratorExpressionDAGChecker::EvaluatingLinkLibraries(const char *tgt)
 {
-  const cmGeneratorExpressionDAGChecker *top = this;
-  const cmGeneratorExpressionDAGChecker *parent = this->Parent;
-  while (parent)
-    {
-    top = parent;
-    parent = parent->Parent;
-    }
-
+  const cmGeneratorExpressionDAGChecker *top = this->Top;
   const char *prop = top->Property.c_str();
 
   if (tgt)
@@ -181,14 +174,7 @@ bool cmGeneratorExpressionDAGChecker::EvaluatingLinkLibraries(const char *tgt)
 
 std::string cmGeneratorExpressionDAGChecker::TopTarget() const
 {
-  const cmGeneratorExpressionDAGChecker *top = this;
-  const cmGeneratorExpressionDAGChecker *parent = this->Parent;
-  while (parent)
-    {
-    top = parent;
-    parent = parent->Parent;
-    }
-  return top->Target;
+  return this->Top->Target;
 }
 
 enum TransitiveProperty {
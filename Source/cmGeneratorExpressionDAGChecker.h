@@ -46,6 +46,7 @@ struct cmGeneratorExpressionDAGChecker
                                   const std::string &property,
                                   const GeneratorExpressionContent *content,
                                   cmGeneratorExpressionDAGChecker *parent);
+  ~cmGeneratorExpressionDAGChecker();
 
   enum Result {
     DAG,
@@ -79,9 +80,13 @@ private:
 
 private:
   const cmGeneratorExpressionDAGChecker * const Parent;
+  const cmGeneratorExpressionDAGChecker * const Top;
   const std::string Target;
   const std::string Property;
   std::map<std::string, std::set<std::string> > Seen;
+  // The properties of each target in the chain of checkers from the
+  // top to the innermost one alive, kept by the top checker.
+  std::map<std::string, std::multiset<std::string> > Active;
   const GeneratorExpressionContent * const Content;
   const cmListFileBacktrace Backtrace;
   Result CheckResult;
@@ -63,11 +63,14 @@ cmGlobalGenerator::cmGlobalGenerator()
   this->ExtraGenerator = 0;
   this->CurrentLocalGenerator = 0;
   this->TryCompileOuterMakefile = 0;
+  this->UsageRequirementsHits = 0;
+  this->UsageRequirementsMisses = 0;
 }
 
 cmGlobalGenerator::~cmGlobalGenerator()
 {
   this->ClearGeneratorMembers();
+  this->ClearGeneratorExpressionParseTrees();
 
   if (this->ExtraGenerator)
     {
@@ -1174,6 +1177,10 @@ void cmGlobalGenerator::Generate()
   // clear targets to issue warning CMP0042 for
   this->CMP0042WarnTargets.clear();
 
+  this->UsageRequirementsHits = 0;
+  this->UsageRequirementsMisses = 0;
+  this->ClearGeneratorExpressionParseTrees();
+
   // Check whether this generator is allowed to run.
   if(!this->CheckALLOW_DUPLICATE_CUSTOM_TARGETS())
     {
@@ -1287,6 +1294,15 @@ void cmGlobalGenerator::Generate()
 
   this->WriteSummary();
 
+  if (this->CMakeInstance->GetDebugOutput())
+    {
+    cmOStringStream msg;
+    msg << "Evaluated target usage requirements "
+        << this->UsageRequirementsMisses << " times and reused them "
+        << this->UsageRequirementsHits << " times.";
+    cmSystemTools::Message(msg.str().c_str());
+    }
+
   if (this->ExtraGenerator != 0)
     {
     this->ExtraGenerator->Generate();
@@ -1311,9 +1327,42 @@ void cmGlobalGenerator::Generate()
                                            cmListFileBacktrace());
     }
 
+  // Generator expression inputs need not stay in memory until the next
+  // generate step.  Expressions still alive keep their own parse tree.
+  this->ClearGeneratorExpressionParseTrees();
+
   this->CMakeInstance->UpdateProgress("Generating done", -1);
 }
 
+//----------------------------------------------------------------------------
+cmGeneratorExpressionParseTree*
+cmGlobalGenerator::GetGeneratorExpressionParseTree(std::string const& input)
+{
+  ParseTreeMapType::iterator i =
+    this->GeneratorExpressionParseTrees.find(&input);
+  if(i == this->GeneratorExpressionParseTrees.end())
+    {
+    cmGeneratorExpressionParseTree* tree =
+      new cmGeneratorExpressionParseTree(input);
+    ParseTreeMapType::value_type entry(&tree->GetInput(), tree);
+    i = this->GeneratorExpressionParseTrees.insert(entry).first;
+    }
+  i->second->Retain();
+  return i->second;
+}
+
+//----------------------------------------------------------------------------
+void cmGlobalGenerator::ClearGeneratorExpressionParseTrees()
+{
+  for(ParseTreeMapType::iterator i =
+        this->GeneratorExpressionParseTrees.begin();
+      i != this->GeneratorExpressionParseTrees.end(); ++i)
+    {
+    i->second->Release();
+    }
+  this->GeneratorExpressionParseTrees.clear();
+}
+
 //----------------------------------------------------------------------------
 bool cmGlobalGenerator::ComputeTargetDepends()
 {
@@ -2957,14 +3006,26 @@ void cmGlobalGenerator::WriteSummary(cmTarget* target)
 //----------------------------------------------------------------------------
 // static
 std::string cmGlobalGenerator::EscapeJSON(const std::string& s) {
-  std::string result;
-  for (std::string::size_type i = 0; i < s.size(); ++i) {
-    if (s[i] == '"' || s[i] == '\\') {
-      result += '\\';
+  cmOStringStream result;
+  cmGlobalGenerator::EscapeJSON(result, s);
+  return result.str();
+}
+
+//----------------------------------------------------------------------------
+// static
+void cmGlobalGenerator::EscapeJSON(std::ostream& os, const std::string& s)
+{
+  // Write the runs of characters between those needing an escape
+  // directly instead of one character at a time.
+  std::string::size_type start = 0;
+  std::string::size_type pos;
+  while((pos = s.find_first_of("\"\\", start)) != s.npos)
+    {
+    os.write(s.data() + start, pos - start);
+    os << '\\' << s[pos];
+    start = pos + 1;
     }
-    result += s[i];
-  }
-  return result;
+  os.write(s.data() + start, s.size() - start);
 }
 
 //----------------------------------------------------------------------------
@@ -308,6 +308,7 @@ public:
   virtual std::string GenerateRuleFile(std::string const& output) const;
 
   static std::string EscapeJSON(const std::string& s);
+  static void EscapeJSON(std::ostream& os, const std::string& s);
 
   void AddEvaluationFile(const std::string &inputFile,
                   cmsys::auto_ptr<cmCompiledGeneratorExpression> outputName,
@@ -329,6 +330,25 @@ public:
 
   virtual void ComputeTargetObjectDirectory(cmGeneratorTarget* gt) const;
 
+  /** Count a lookup of target usage requirements evaluated earlier
+      while generating.  */
+  void CountUsageRequirementsLookup(bool found)
+    {
+    if (found)
+      {
+      ++this->UsageRequirementsHits;
+      }
+    else
+      {
+      ++this->UsageRequirementsMisses;
+      }
+    }
+
+  /** Get the parse tree shared while generating by the generator
+      expressions with the given input.  The caller must release it.  */
+  cmGeneratorExpressionParseTree*
+  GetGeneratorExpressionParseTree(std::string const& input);
+
 protected:
   typedef std::vector<cmLocalGenerator*> GeneratorVector;
   // for a project collect all its targets by following depend
@@ -410,6 +430,19 @@ protected:
 private:
   cmMakefile* TryCompileOuterMakefile;
   float FirstTimeProgress;
+  unsigned long UsageRequirementsHits;
+  unsigned long UsageRequirementsMisses;
+
+  // Generator expression parse trees keyed by the input they hold.
+  struct ParseTreeInputLess
+  {
+    bool operator()(std::string const* l, std::string const* r) const
+      { return *l < *r; }
+  };
+  typedef std::map<std::string const*, cmGeneratorExpressionParseTree*,
+                   ParseTreeInputLess> ParseTreeMapType;
+  ParseTreeMapType GeneratorExpressionParseTrees;
+  void ClearGeneratorExpressionParseTrees();
   // If you add a new map here, make sure it is copied
   // in EnableLanguagesFromGenerator
   std::map<std::string, bool> IgnoreExtensions;
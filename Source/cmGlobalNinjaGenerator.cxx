@@ -23,6 +23,14 @@
 
 const char* cmGlobalNinjaGenerator::NINJA_BUILD_FILE = "build.ninja";
 const char* cmGlobalNinjaGenerator::NINJA_RULES_FILE = "rules.ninja";
+const char* cmGlobalNinjaGenerator::NINJA_DIRECTORY_FILE = "directory.ninja";
+const char* cmGlobalNinjaGenerator::NINJA_TARGET_FILE = "target.ninja";
+
+// The number of the next variable named by EncodeIdent().  It restarts in
+// each included file so that a change in one file does not renumber the
+// variables of all files written after it.  Paths are expanded as soon as
+// ninja reads them, so a later file may bind the same names again.
+static unsigned int cmGlobalNinjaGeneratorIdentNum = 0;
 const char* cmGlobalNinjaGenerator::INDENT = "  ";
 
 void cmGlobalNinjaGenerator::Indent(std::ostream& os, int count)
@@ -70,9 +78,8 @@ std::string cmGlobalNinjaGenerator::EncodeIdent(const std::string &ident,
                                                 std::ostream &vars) {
   if (std::find_if(ident.begin(), ident.end(),
                    std::not1(std::ptr_fun(IsIdentChar))) != ident.end()) {
-    static unsigned VarNum = 0;
     cmOStringStream names;
-    names << "ident" << VarNum++;
+    names << "ident" << cmGlobalNinjaGeneratorIdentNum++;
     vars << names.str() << " = " << ident << "\n";
     return "$" + names.str();
   } else {
@@ -272,7 +279,7 @@ cmGlobalNinjaGenerator::WriteCustomCommandBuild(const std::string& command,
   vars["COMMAND"] = cmd;
   vars["DESC"] = EncodeLiteral(description);
 
-  this->WriteBuild(*this->BuildFileStream,
+  this->WriteBuild(*this->GetBuildFileStream(),
                    comment,
                    "CUSTOM_COMMAND",
                    outputs,
@@ -318,7 +325,7 @@ cmGlobalNinjaGenerator::WriteMacOSXContentBuild(const std::string& input,
   deps.push_back(input);
   cmNinjaVars vars;
 
-  this->WriteBuild(*this->BuildFileStream,
+  this->WriteBuild(*this->GetBuildFileStream(),
                    "",
                    "COPY_OSX_CONTENT",
                    outputs,
@@ -467,6 +474,8 @@ cmGlobalNinjaGenerator::cmGlobalNinjaGenerator()
   : cmGlobalGenerator()
   , BuildFileStream(0)
   , RulesFileStream(0)
+  , DirectoryFileStream(0)
+  , TargetFileStream(0)
   , CompileCommandsStream(0)
   , Rules()
   , AllDependencies()
@@ -693,6 +702,111 @@ void cmGlobalNinjaGenerator::CloseBuildFileStream()
    }
 }
 
+void
+cmGlobalNinjaGenerator::OpenDirectoryFileStream(cmLocalNinjaGenerator* lg)
+{
+  std::string directoryFile = lg->GetHomeRelativeOutputPath();
+  if (!directoryFile.empty())
+    {
+    directoryFile += "/";
+    }
+  directoryFile += cmake::GetCMakeFilesDirectoryPostSlash();
+  directoryFile += cmGlobalNinjaGenerator::NINJA_DIRECTORY_FILE;
+  std::string comment = "Build statements of directory ";
+  comment += lg->GetMakefile()->GetStartOutputDirectory();
+  this->DirectoryFileStream =
+    this->OpenIncludedFileStream(*this->BuildFileStream, directoryFile,
+                                 comment, "one directory");
+}
+
+void cmGlobalNinjaGenerator::CloseDirectoryFileStream()
+{
+  this->CloseIncludedFileStream(this->DirectoryFileStream, "Directory");
+}
+
+void
+cmGlobalNinjaGenerator::OpenTargetFileStream(cmLocalNinjaGenerator* lg,
+                                             cmTarget const& target)
+{
+  if (!this->DirectoryFileStream)
+    {
+    cmSystemTools::Error("Directory file stream was not open.");
+    return;
+    }
+  std::string targetFile = lg->GetHomeRelativeOutputPath();
+  if (!targetFile.empty())
+    {
+    targetFile += "/";
+    }
+  targetFile += lg->GetTargetDirectory(target);
+  targetFile += "/";
+  targetFile += cmGlobalNinjaGenerator::NINJA_TARGET_FILE;
+  this->TargetFileStream =
+    this->OpenIncludedFileStream(*this->DirectoryFileStream, targetFile,
+                                 "Build statements of target "
+                                 + target.GetName(), "one target");
+}
+
+void cmGlobalNinjaGenerator::CloseTargetFileStream()
+{
+  this->CloseIncludedFileStream(this->TargetFileStream, "Target");
+}
+
+cmGeneratedFileStream*
+cmGlobalNinjaGenerator::OpenIncludedFileStream(std::ostream& includer,
+                                               std::string const& file,
+                                               std::string const& comment,
+                                               const char* contents)
+{
+  // Include the file, given relative to the top of the build tree.
+  std::string includePath = EncodePath(file);
+  cmSystemTools::ReplaceString(includePath, " ", "$ ");
+  cmGlobalNinjaGenerator::WriteInclude(includer, includePath, comment);
+  includer << "\n";
+
+  std::string filePath = this->GetCMakeInstance()->GetHomeOutputDirectory();
+  filePath += "/";
+  filePath += file;
+  cmSystemTools::MakeDirectory(
+    cmSystemTools::GetFilenamePath(filePath).c_str());
+
+  // Leave the file untouched if its content does not change so that
+  // its time stamp tells which parts of the build changed.
+  cmGeneratedFileStream* stream = new cmGeneratedFileStream(filePath.c_str());
+  stream->SetCopyIfDifferent(true);
+  cmGlobalNinjaGeneratorIdentNum = 0;
+
+  // Write the do not edit header.
+  this->WriteDisclaimer(*stream);
+
+  // Write a comment about this file.
+  *stream
+    << "# This file contains the build statements of " << contents << ".\n"
+    << "# It is included in the main '" << NINJA_BUILD_FILE << "'.\n\n"
+    ;
+  return stream;
+}
+
+void
+cmGlobalNinjaGenerator::CloseIncludedFileStream(
+  cmGeneratedFileStream*& stream, const char* name)
+{
+  if (stream)
+    {
+    if (cmSystemTools::GetErrorOccuredFlag())
+      {
+      stream->setstate(std::ios_base::failbit);
+      }
+    delete stream;
+    stream = 0;
+    cmGlobalNinjaGeneratorIdentNum = 0;
+    }
+  else
+    {
+    cmSystemTools::Error(name, " file stream was not open.");
+   }
+}
+
 void cmGlobalNinjaGenerator::OpenRulesFileStream()
 {
   // Compute Ninja's build file path.
@@ -711,6 +825,8 @@ void cmGlobalNinjaGenerator::OpenRulesFileStream()
       // open the file.
       return;
       }
+    // Replace the file only if its content changes.
+    this->RulesFileStream->SetCopyIfDifferent(true);
     }
 
   // Write the do not edit header.
@@ -751,9 +867,12 @@ void cmGlobalNinjaGenerator::AddCXXCompileCommand(
     // Get a stream where to generate things.
     this->CompileCommandsStream =
       new cmGeneratedFileStream(buildFilePath.c_str());
+    // Leave the file alone if no command changed so that tools
+    // watching it do not reload it.
+    this->CompileCommandsStream->SetCopyIfDifferent(true);
     *this->CompileCommandsStream << "[";
     } else {
-    *this->CompileCommandsStream << "," << std::endl;
+    *this->CompileCommandsStream << ",\n";
     }
 
   std::string sourceFileName = sourceFile;
@@ -766,12 +885,15 @@ void cmGlobalNinjaGenerator::AddCXXCompileCommand(
 
 
   *this->CompileCommandsStream << "\n{\n"
-     << "  \"directory\": \""
-     << cmGlobalGenerator::EscapeJSON(buildFileDir) << "\",\n"
-     << "  \"command\": \""
-     << cmGlobalGenerator::EscapeJSON(commandLine) << "\",\n"
-     << "  \"file\": \""
-     << cmGlobalGenerator::EscapeJSON(sourceFileName) << "\"\n"
+     << "  \"directory\": \"";
+  cmGlobalGenerator::EscapeJSON(*this->CompileCommandsStream, buildFileDir);
+  *this->CompileCommandsStream << "\",\n"
+     << "  \"command\": \"";
+  cmGlobalGenerator::EscapeJSON(*this->CompileCommandsStream, commandLine);
+  *this->CompileCommandsStream << "\",\n"
+     << "  \"file\": \"";
+  cmGlobalGenerator::EscapeJSON(*this->CompileCommandsStream, sourceFileName);
+  *this->CompileCommandsStream << "\"\n"
      << "}";
 }
 
@@ -892,6 +1014,57 @@ cmGlobalNinjaGenerator
   }
 }
 
+void
+cmGlobalNinjaGenerator
+::AppendTargetOrderDepends(cmTarget const* target, cmNinjaDeps& outputs)
+{
+  // Compiling the objects of a target needs only what its dependencies
+  // produce before compiling their own objects, such as headers generated
+  // by custom commands.  Leave the full outputs of linkable dependencies
+  // to the link step so that compilation does not wait for them to link.
+  // Framework and bundle content and the files written by build events
+  // are produced only with the full outputs, so wait for those.
+  cmTargetDependSet const& targetDeps =
+    this->GetTargetDirectDepends(*target);
+  for (cmTargetDependSet::const_iterator i = targetDeps.begin();
+       i != targetDeps.end(); ++i)
+    {
+    switch ((*i)->GetType())
+      {
+      case cmTarget::EXECUTABLE:
+      case cmTarget::SHARED_LIBRARY:
+      case cmTarget::STATIC_LIBRARY:
+      case cmTarget::MODULE_LIBRARY:
+      case cmTarget::OBJECT_LIBRARY:
+        if ((*i)->IsFrameworkOnApple() || (*i)->IsAppBundleOnApple() ||
+            (*i)->IsCFBundleOnApple() ||
+            !(*i)->GetPreBuildCommands().empty() ||
+            !(*i)->GetPreLinkCommands().empty() ||
+            !(*i)->GetPostBuildCommands().empty())
+          {
+          this->AppendTargetOutputs(*i, outputs);
+          }
+        else
+          {
+          outputs.push_back(this->OrderDependsTargetForTarget(*i));
+          }
+        break;
+      case cmTarget::INTERFACE_LIBRARY:
+        break;
+      default:
+        // Utility targets may produce anything the objects need.
+        this->AppendTargetOutputs(*i, outputs);
+        break;
+      }
+    }
+}
+
+std::string
+cmGlobalNinjaGenerator::OrderDependsTargetForTarget(cmTarget const* target)
+{
+  return "cmake_order_depends_target_" + target->GetName();
+}
+
 void cmGlobalNinjaGenerator::AddTargetAlias(const std::string& alias,
                                             cmTarget* target) {
   cmNinjaDeps outputs;
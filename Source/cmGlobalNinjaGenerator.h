@@ -20,6 +20,7 @@
 //#define NINJA_GEN_VERBOSE_FILES
 
 class cmLocalGenerator;
+class cmLocalNinjaGenerator;
 class cmGeneratedFileStream;
 class cmGeneratorTarget;
 
@@ -35,7 +36,9 @@ class cmGeneratorTarget;
  *   it itself.
  * - We don't care about generating a clean target since Ninja already have
  *   a clean tool.
- * - We generate one build.ninja and one rules.ninja per project.
+ * - We generate one build.ninja and one rules.ninja per project.  The
+ *   build statements of each directory and target are written to files of
+ *   their own included by build.ninja.
  * - We try to minimize the number of generated rules: one per target and
  *   language.
  * - We use Ninja special variable $in and $out to produce nice output.
@@ -48,6 +51,16 @@ public:
   /// The default name of Ninja's build file. Typically: build.ninja.
   static const char* NINJA_BUILD_FILE;
 
+  /// The name of the file holding the build statements of a directory,
+  /// in its CMakeFiles directory. Typically: directory.ninja.
+  /// It is included in the main build.ninja file.
+  static const char* NINJA_DIRECTORY_FILE;
+
+  /// The name of the file holding the build statements of a target,
+  /// in its target directory. Typically: target.ninja.
+  /// It is included in the file of the target's directory.
+  static const char* NINJA_TARGET_FILE;
+
   /// The default name of Ninja's rules file. Typically: rules.ninja.
   /// It is included in the main build.ninja file.
   static const char* NINJA_RULES_FILE;
@@ -226,7 +239,21 @@ public:
 
 
   cmGeneratedFileStream* GetBuildFileStream() const {
-    return this->BuildFileStream; }
+    return this->TargetFileStream ? this->TargetFileStream
+         : this->DirectoryFileStream ? this->DirectoryFileStream
+         : this->BuildFileStream; }
+
+  /// Send the build statements of the given directory to a file of their
+  /// own until CloseDirectoryFileStream() is called.  The file is included
+  /// by the main build file and replaced only if its content changes.
+  void OpenDirectoryFileStream(cmLocalNinjaGenerator* lg);
+  void CloseDirectoryFileStream();
+
+  /// Likewise for the build statements of a target, in a file included by
+  /// the file of its directory.
+  void OpenTargetFileStream(cmLocalNinjaGenerator* lg,
+                            cmTarget const& target);
+  void CloseTargetFileStream();
 
   cmGeneratedFileStream* GetRulesFileStream() const {
     return this->RulesFileStream; }
@@ -285,6 +312,8 @@ public:
 
   void AppendTargetOutputs(cmTarget const* target, cmNinjaDeps& outputs);
   void AppendTargetDepends(cmTarget const* target, cmNinjaDeps& outputs);
+  void AppendTargetOrderDepends(cmTarget const* target, cmNinjaDeps& outputs);
+  static std::string OrderDependsTargetForTarget(cmTarget const* target);
   void AddDependencyToAll(cmTarget* target);
   void AddDependencyToAll(const std::string& input);
 
@@ -319,6 +348,13 @@ private:
   void OpenRulesFileStream();
   void CloseRulesFileStream();
 
+  cmGeneratedFileStream* OpenIncludedFileStream(std::ostream& includer,
+                                                std::string const& file,
+                                                std::string const& comment,
+                                                const char* contents);
+  void CloseIncludedFileStream(cmGeneratedFileStream*& stream,
+                               const char* name);
+
   /// Write the common disclaimer text at the top of each build file.
   void WriteDisclaimer(std::ostream& os);
 
@@ -342,6 +378,12 @@ private:
   /// The file containing the rule statements. (The action attached to each
   /// edge of the compilation DAG).
   cmGeneratedFileStream* RulesFileStream;
+  /// The file containing the build statements of the directory being
+  /// generated, if any.
+  cmGeneratedFileStream* DirectoryFileStream;
+  /// The file containing the build statements of the target being
+  /// generated, if any.
+  cmGeneratedFileStream* TargetFileStream;
   cmGeneratedFileStream* CompileCommandsStream;
 
   /// The type used to store the set of rules added to the generated build
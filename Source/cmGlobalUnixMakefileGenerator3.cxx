@@ -170,7 +170,7 @@ void cmGlobalUnixMakefileGenerator3::Generate()
   this->WriteMainCMakefile();
 
   if (this->CommandDatabase != NULL) {
-    *this->CommandDatabase << std::endl << "]";
+    *this->CommandDatabase << "\n]";
     delete this->CommandDatabase;
     this->CommandDatabase = NULL;
   }
@@ -186,20 +186,23 @@ void cmGlobalUnixMakefileGenerator3::AddCXXCompileCommand(
       + "/compile_commands.json";
     this->CommandDatabase =
       new cmGeneratedFileStream(commandDatabaseName.c_str());
-    *this->CommandDatabase << "[" << std::endl;
+    // Leave the file alone if no command changed so that tools
+    // watching it do not reload it.
+    this->CommandDatabase->SetCopyIfDifferent(true);
+    *this->CommandDatabase << "[\n";
     } else {
-    *this->CommandDatabase << "," << std::endl;
+    *this->CommandDatabase << ",\n";
     }
-  *this->CommandDatabase << "{" << std::endl
-      << "  \"directory\": \""
-      << cmGlobalGenerator::EscapeJSON(workingDirectory) << "\","
-      << std::endl
-      << "  \"command\": \"" <<
-      cmGlobalGenerator::EscapeJSON(compileCommand) << "\","
-      << std::endl
-      << "  \"file\": \"" <<
-      cmGlobalGenerator::EscapeJSON(sourceFile) << "\""
-      << std::endl << "}";
+  *this->CommandDatabase << "{\n"
+      << "  \"directory\": \"";
+  cmGlobalGenerator::EscapeJSON(*this->CommandDatabase, workingDirectory);
+  *this->CommandDatabase << "\",\n"
+      << "  \"command\": \"";
+  cmGlobalGenerator::EscapeJSON(*this->CommandDatabase, compileCommand);
+  *this->CommandDatabase << "\",\n"
+      << "  \"file\": \"";
+  cmGlobalGenerator::EscapeJSON(*this->CommandDatabase, sourceFile);
+  *this->CommandDatabase << "\"\n}";
 }
 
 void cmGlobalUnixMakefileGenerator3::WriteMainMakefile2()
@@ -757,10 +760,16 @@ cmGlobalUnixMakefileGenerator3
         << localName << "\n\n";
 
       commands.clear();
-      makeTargetName = localName;
-      makeTargetName += "/depend";
-      commands.push_back(lg->GetRecursiveMakeCall
-                         (makefileName.c_str(),makeTargetName));
+
+      // Skip the make process for a depend step with nothing to do.
+      if(this->NoDependStepTargets.find(gtarget->Target) ==
+         this->NoDependStepTargets.end())
+        {
+        makeTargetName = localName;
+        makeTargetName += "/depend";
+        commands.push_back(lg->GetRecursiveMakeCall
+                           (makefileName.c_str(),makeTargetName));
+        }
 
       // add requires if we need it for this generator
       if (needRequiresStep)
@@ -782,26 +791,25 @@ cmGlobalUnixMakefileGenerator3
       std::string progressDir =
         lg->GetMakefile()->GetHomeOutputDirectory();
       progressDir += cmake::GetCMakeFilesDirectory();
+      cmLocalUnixMakefileGenerator3::EchoProgress progress;
+      progress.Dir = progressDir;
         {
-        cmOStringStream progCmd;
-        progCmd << "$(CMAKE_COMMAND) -E cmake_progress_report ";
-        // all target counts
-        progCmd << lg->Convert(progressDir,
-                                cmLocalGenerator::FULL,
-                                cmLocalGenerator::SHELL);
-        progCmd << " ";
+        cmOStringStream progressArg;
+        const char* sep = "";
         std::vector<unsigned long>& progFiles =
           this->ProgressMap[gtarget->Target].Marks;
         for (std::vector<unsigned long>::iterator i = progFiles.begin();
               i != progFiles.end(); ++i)
           {
-          progCmd << " " << *i;
+          progressArg << sep << *i;
+          sep = ",";
           }
-        commands.push_back(progCmd.str());
+        progress.Arg = progressArg.str();
         }
-      progressDir = "Built target ";
-      progressDir += name;
-      lg->AppendEcho(commands,progressDir.c_str());
+      std::string echo = "Built target ";
+      echo += name;
+      lg->AppendEcho(commands, echo.c_str(),
+                     cmLocalUnixMakefileGenerator3::EchoNormal, &progress);
 
       this->AppendGlobalTargetDepends(depends,*gtarget->Target);
       lg->WriteMakeRule(ruleFileStream, "All Build rule for target.",
@@ -957,6 +965,17 @@ cmGlobalUnixMakefileGenerator3::RecordTargetProgress(
   tp.VariableFile = tg->GetProgressFileNameFull();
 }
 
+//----------------------------------------------------------------------------
+void
+cmGlobalUnixMakefileGenerator3::RecordTargetDependStep(
+  cmMakefileTargetGenerator* tg)
+{
+  if(!tg->GetNeedDependStep())
+    {
+    this->NoDependStepTargets.insert(tg->GetTarget());
+    }
+}
+
 //----------------------------------------------------------------------------
 void
 cmGlobalUnixMakefileGenerator3::TargetProgress
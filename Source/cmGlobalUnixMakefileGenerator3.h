@@ -121,6 +121,9 @@ public:
   /** Record per-target progress information.  */
   void RecordTargetProgress(cmMakefileTargetGenerator* tg);
 
+  /** Record whether the depend step of a target has anything to do.  */
+  void RecordTargetDependStep(cmMakefileTargetGenerator* tg);
+
   void AddCXXCompileCommand(const std::string &sourceFile,
                             const std::string &workingDirectory,
                             const std::string &compileCommand);
@@ -189,6 +192,9 @@ protected:
                    cmStrictTargetComparison> ProgressMapType;
   ProgressMapType ProgressMap;
 
+  // Targets whose depend step has nothing to do.
+  std::set<cmTarget const*> NoDependStepTargets;
+
   size_t CountProgressMarksInTarget(cmTarget const* target,
                                     std::set<cmTarget const*>& emitted);
   size_t CountProgressMarksInAll(cmLocalUnixMakefileGenerator3* lg);
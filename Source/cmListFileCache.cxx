@@ -15,8 +15,14 @@
 #include "cmSystemTools.h"
 #include "cmMakefile.h"
 #include "cmVersion.h"
+#include "cmGeneratedFileStream.h"
+
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+# include "cmCryptoHash.h"
+#endif
 
 #include <cmsys/RegularExpression.hxx>
+#include <cmsys/FStream.hxx>
 
 #ifdef __BORLANDC__
 # pragma warn -8060 /* possibly incorrect assignment */
@@ -37,13 +43,14 @@ struct cmListFileParser
   cmListFileLexer* Lexer;
   cmListFileFunction Function;
   enum { SeparationOkay, SeparationWarning, SeparationError} Separation;
+  bool Diagnosed;
 };
 
 //----------------------------------------------------------------------------
 cmListFileParser::cmListFileParser(cmListFile* lf, cmMakefile* mf,
                                    const char* filename):
   ListFile(lf), Makefile(mf), FileName(filename),
-  Lexer(cmListFileLexer_New())
+  Lexer(cmListFileLexer_New()), Diagnosed(false)
 {
 }
 
@@ -147,12 +154,25 @@ bool cmListFile::ParseFile(const char* filename,
     }
 
   bool parseError = false;
-  this->ModifiedTime = cmSystemTools::ModifiedTime(filename);
+  cmListFileCache* cache = mf->GetCMakeInstance()->GetListFileCache();
+  if(cmListFile const* cached = cache->GetListFile(filename))
+    {
+    this->ModifiedTime = cached->ModifiedTime;
+    this->Functions = cached->Functions;
+    }
+  else
+    {
+    this->ModifiedTime = cmSystemTools::ModifiedTime(filename);
+    cmListFileParser parser(this, mf, filename);
+    parseError = !parser.ParseFile();
 
-  {
-  cmListFileParser parser(this, mf, filename);
-  parseError = !parser.ParseFile();
-  }
+    // Do not cache a file whose parse produced diagnostics so that
+    // they are reported again each time the file is read.
+    if(!parseError && !parser.Diagnosed)
+      {
+      cache->AddListFile(filename, *this);
+      }
+    }
 
   if(parseError)
     {
@@ -388,6 +408,7 @@ bool cmListFileParser::AddArgument(cmListFileLexer_Token* token,
     {
     return true;
     }
+  this->Diagnosed = true;
   bool isError = (this->Separation == SeparationError ||
                   delim == cmListFileArgument::Bracket);
   cmOStringStream m;
@@ -421,3 +442,248 @@ std::ostream& operator<<(std::ostream& os, cmListFileContext const& lfc)
     }
   return os;
 }
+
+//----------------------------------------------------------------------------
+cmListFileCache::cmListFileCache(): Modified(false)
+{
+}
+
+//----------------------------------------------------------------------------
+std::string cmListFileCache::ComputeHash(const std::string& path)
+{
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  cmCryptoHashMD5 md5;
+  return md5.HashFile(path);
+#else
+  (void)path;
+  return std::string();
+#endif
+}
+
+//----------------------------------------------------------------------------
+void cmListFileCache::SetFilePath(std::string const& path, cmListFile& lf)
+{
+  // The arguments refer to the file path by pointer, so point them at
+  // the map key which lives as long as the entry.
+  for(std::vector<cmListFileFunction>::iterator fi = lf.Functions.begin();
+      fi != lf.Functions.end(); ++fi)
+    {
+    fi->FilePath = path;
+    for(std::vector<cmListFileArgument>::iterator ai = fi->Arguments.begin();
+        ai != fi->Arguments.end(); ++ai)
+      {
+      ai->FilePath = path.c_str();
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+cmListFile const* cmListFileCache::GetListFile(const std::string& path)
+{
+  EntryMap::iterator i = this->Entries.find(path);
+  if(i == this->Entries.end() || i->second.Hash.empty())
+    {
+    return 0;
+    }
+  Entry& e = i->second;
+  long int mtime = cmSystemTools::ModifiedTime(path.c_str());
+  bool touched = mtime != e.ListFile.ModifiedTime;
+  if(cmSystemTools::FileLength(path.c_str()) != e.Size ||
+     ((touched || !e.Verified) && ComputeHash(path) != e.Hash))
+    {
+    // Keep the entry so that argument file paths still pointing at
+    // its key remain valid, but never use its content again.
+    e.Hash = "";
+    e.Used = false;
+    e.Verified = false;
+    this->Modified = true;
+    return 0;
+    }
+  if(touched)
+    {
+    // Only the time stamp changed.  Remember the new one.
+    e.ListFile.ModifiedTime = mtime;
+    this->Modified = true;
+    }
+
+  // The content matches.  Unless the file was modified so recently
+  // that it could change again without a new time stamp, trust the
+  // time stamp and size for the rest of this run.
+  e.Verified = mtime < static_cast<long int>(time(0)) - 1;
+  e.Used = true;
+  return &e.ListFile;
+}
+
+//----------------------------------------------------------------------------
+void cmListFileCache::AddListFile(const std::string& path,
+                                  cmListFile const& lf)
+{
+  std::string hash = ComputeHash(path);
+  if(hash.empty())
+    {
+    return;
+    }
+  EntryMap::iterator i =
+    this->Entries.insert(EntryMap::value_type(path, Entry())).first;
+  Entry& e = i->second;
+  e.Size = cmSystemTools::FileLength(path.c_str());
+  e.Hash = hash;
+  e.Used = true;
+  e.Verified = lf.ModifiedTime < static_cast<long int>(time(0)) - 1;
+  e.ListFile = lf;
+  SetFilePath(i->first, e.ListFile);
+  this->Modified = true;
+}
+
+//----------------------------------------------------------------------------
+static void cmListFileCacheWriteString(std::ostream& os, std::string const& s)
+{
+  os << s.size() << ":";
+  os.write(s.data(), static_cast<std::streamsize>(s.size()));
+  os << "\n";
+}
+
+//----------------------------------------------------------------------------
+static bool cmListFileCacheReadString(std::istream& is, size_t limit,
+                                      std::string& s)
+{
+  // A length beyond the size of the file means it is corrupt.
+  size_t n;
+  char c;
+  if(!(is >> n) || n > limit || !is.get(c) || c != ':')
+    {
+    return false;
+    }
+  s.resize(n);
+  return n == 0 || is.read(&s[0], static_cast<std::streamsize>(n));
+}
+
+//----------------------------------------------------------------------------
+static std::string cmListFileCacheHeader()
+{
+  std::string header = "# CMake list file cache, version ";
+  header += cmVersion::GetCMakeVersion();
+  return header;
+}
+
+//----------------------------------------------------------------------------
+bool cmListFileCache::Load(const std::string& file)
+{
+  this->Entries.clear();
+  this->Modified = false;
+
+  cmsys::ifstream fin(file.c_str(), std::ios::in | std::ios::binary);
+  // No string or count stored in the file can exceed its size.
+  size_t limit = cmSystemTools::FileLength(file.c_str());
+  std::string header;
+  if(!fin || !std::getline(fin, header) || header != cmListFileCacheHeader())
+    {
+    return false;
+    }
+
+  std::string path;
+  bool corrupt = false;
+  while(!corrupt && cmListFileCacheReadString(fin, limit, path))
+    {
+    Entry& e = this->Entries[path];
+    size_t numFunctions = 0;
+    if(!(fin >> e.ListFile.ModifiedTime >> e.Size) ||
+       !cmListFileCacheReadString(fin, limit, e.Hash) ||
+       !(fin >> numFunctions) || numFunctions > limit)
+      {
+      corrupt = true;
+      break;
+      }
+    e.ListFile.Functions.resize(numFunctions);
+    bool ok = true;
+    for(std::vector<cmListFileFunction>::iterator
+          fi = e.ListFile.Functions.begin();
+        ok && fi != e.ListFile.Functions.end(); ++fi)
+      {
+      size_t numArguments = 0;
+      ok = (cmListFileCacheReadString(fin, limit, fi->Name) &&
+            (fin >> fi->Line >> numArguments) && numArguments <= limit);
+      if(ok)
+        {
+        fi->Arguments.resize(numArguments);
+        }
+      for(std::vector<cmListFileArgument>::iterator
+            ai = fi->Arguments.begin();
+          ok && ai != fi->Arguments.end(); ++ai)
+        {
+        int delim = 0;
+        ok = ((fin >> delim >> ai->Line) &&
+              delim >= cmListFileArgument::Unquoted &&
+              delim <= cmListFileArgument::Bracket &&
+              cmListFileCacheReadString(fin, limit, ai->Value));
+        ai->Delim = static_cast<cmListFileArgument::Delimiter>(delim);
+        }
+      }
+    corrupt = !ok;
+    SetFilePath(this->Entries.find(path)->first, e.ListFile);
+    }
+
+  if(corrupt || !fin.eof())
+    {
+    // The file is corrupt.  Discard everything.
+    this->Entries.clear();
+    return false;
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool cmListFileCache::Save(const std::string& file)
+{
+  // Entries not used by this run are dropped.
+  for(EntryMap::iterator i = this->Entries.begin();
+      i != this->Entries.end();)
+    {
+    if(i->second.Used)
+      {
+      ++i;
+      }
+    else
+      {
+      this->Entries.erase(i++);
+      this->Modified = true;
+      }
+    }
+  if(!this->Modified && cmSystemTools::FileExists(file.c_str()))
+    {
+    return true;
+    }
+
+  cmGeneratedFileStream fout;
+  fout.SetCopyIfDifferent(true);
+  fout.Open(file.c_str(), true, true);
+  fout << cmListFileCacheHeader() << "\n";
+  for(EntryMap::const_iterator i = this->Entries.begin();
+      i != this->Entries.end(); ++i)
+    {
+    Entry const& e = i->second;
+    cmListFileCacheWriteString(fout, i->first);
+    fout << e.ListFile.ModifiedTime << " " << e.Size << "\n";
+    cmListFileCacheWriteString(fout, e.Hash);
+    fout << e.ListFile.Functions.size() << "\n";
+    for(std::vector<cmListFileFunction>::const_iterator
+          fi = e.ListFile.Functions.begin();
+        fi != e.ListFile.Functions.end(); ++fi)
+      {
+      cmListFileCacheWriteString(fout, fi->Name);
+      fout << fi->Line << " " << fi->Arguments.size() << "\n";
+      for(std::vector<cmListFileArgument>::const_iterator
+            ai = fi->Arguments.begin(); ai != fi->Arguments.end(); ++ai)
+        {
+        fout << static_cast<int>(ai->Delim) << " " << ai->Line << " ";
+        cmListFileCacheWriteString(fout, ai->Value);
+        }
+      }
+    }
+  if(!fout.Close())
+    {
+    return false;
+    }
+  this->Modified = false;
+  return true;
+}
@@ -14,14 +14,8 @@
 
 #include "cmStandardIncludes.h"
 
-/** \class cmListFileCache
- * \brief A class to cache list file contents.
- *
- * cmListFileCache is a class used to cache the contents of parsed
- * cmake list files.
- */
-
 class cmMakefile;
+class cmCommand;
 
 struct cmListFileArgument
 {
@@ -63,7 +57,13 @@ std::ostream& operator<<(std::ostream&, cmListFileContext const&);
 
 struct cmListFileFunction: public cmListFileContext
 {
+  cmListFileFunction(): Command(0), CommandGeneration(0) {}
   std::vector<cmListFileArgument> Arguments;
+
+  // The command this call resolved to, valid while the command table
+  // generation is unchanged.  See cmake::ResolveCommand.
+  mutable cmCommand* Command;
+  mutable unsigned long CommandGeneration;
 };
 
 class cmListFileBacktrace: public std::vector<cmListFileContext> {};
@@ -82,6 +82,52 @@ struct cmListFile
   std::vector<cmListFileFunction> Functions;
 };
 
+/** \class cmListFileCache
+ * \brief A class to cache list file contents.
+ *
+ * cmListFileCache is a class used to cache the contents of parsed
+ * cmake list files.  Each entry is validated against the modification
+ * time, size and content hash of the file on disk, so a list file
+ * included from many directories is lexed only once per run.  The
+ * cache may be saved to and loaded from a file in the build tree so
+ * that later runs can skip lexing unchanged files entirely.
+ */
+class cmListFileCache
+{
+public:
+  cmListFileCache();
+
+  /** Return the cached parse of the given file if it is still up to
+      date with the file on disk, or 0 if the file must be parsed.  */
+  cmListFile const* GetListFile(const std::string& path);
+
+  /** Record the parse of the given file.  */
+  void AddListFile(const std::string& path, cmListFile const& lf);
+
+  /** Load/save the cache from/to the given file.  Saving writes only
+      entries used since the cache was loaded and does nothing if no
+      entry changed.  */
+  bool Load(const std::string& file);
+  bool Save(const std::string& file);
+
+private:
+  struct Entry
+  {
+    Entry(): Size(0), Used(false), Verified(false) {}
+    unsigned long Size;
+    std::string Hash;
+    bool Used;
+    bool Verified;
+    cmListFile ListFile;
+  };
+  typedef std::map<std::string, Entry> EntryMap;
+  EntryMap Entries;
+  bool Modified;
+
+  static std::string ComputeHash(const std::string& path);
+  static void SetFilePath(std::string const& path, cmListFile& lf);
+};
+
 struct cmValueWithOrigin {
   cmValueWithOrigin(const std::string &value,
                           const cmListFileBacktrace &bt)
@@ -43,11 +43,6 @@ void cmLocalNinjaGenerator::Generate()
 {
   this->SetConfigName();
 
-  this->WriteProcessedMakefile(this->GetBuildFileStream());
-#ifdef NINJA_GEN_VERBOSE_FILES
-  this->WriteProcessedMakefile(this->GetRulesFileStream());
-#endif
-
   // We do that only once for the top CMakeLists.txt file.
   if(this->isRootMakefile())
     {
@@ -66,6 +61,14 @@ void cmLocalNinjaGenerator::Generate()
       }
     }
 
+  // Write the build statements of this directory to a file of its own.
+  this->GetGlobalNinjaGenerator()->OpenDirectoryFileStream(this);
+
+  this->WriteProcessedMakefile(this->GetBuildFileStream());
+#ifdef NINJA_GEN_VERBOSE_FILES
+  this->WriteProcessedMakefile(this->GetRulesFileStream());
+#endif
+
   cmGeneratorTargetsType targets = this->GetMakefile()->GetGeneratorTargets();
   for(cmGeneratorTargetsType::iterator t = targets.begin();
       t != targets.end(); ++t)
@@ -78,7 +81,10 @@ void cmLocalNinjaGenerator::Generate()
     cmNinjaTargetGenerator* tg = cmNinjaTargetGenerator::New(t->second);
     if(tg)
       {
+      this->GetGlobalNinjaGenerator()->OpenTargetFileStream(
+        this, *t->second->Target);
       tg->Generate();
+      this->GetGlobalNinjaGenerator()->CloseTargetFileStream();
       // Add the target to "all" if required.
       if (!this->GetGlobalNinjaGenerator()->IsExcluded(
             this->GetGlobalNinjaGenerator()->GetLocalGenerators()[0],
@@ -89,6 +95,8 @@ void cmLocalNinjaGenerator::Generate()
     }
 
   this->WriteCustomCommandBuildStatements();
+
+  this->GetGlobalNinjaGenerator()->CloseDirectoryFileStream();
 }
 
 // Implemented in:
@@ -317,6 +325,13 @@ cmLocalNinjaGenerator
   this->GetGlobalNinjaGenerator()->AppendTargetDepends(target, outputs);
 }
 
+void
+cmLocalNinjaGenerator
+::AppendTargetOrderDepends(cmTarget* target, cmNinjaDeps& outputs)
+{
+  this->GetGlobalNinjaGenerator()->AppendTargetOrderDepends(target, outputs);
+}
+
 void cmLocalNinjaGenerator::AppendCustomCommandDeps(
   cmCustomCommandGenerator const& ccg,
   cmNinjaDeps &ninjaDeps)
@@ -161,6 +161,7 @@ void cmLocalUnixMakefileGenerator3::Generate()
       {
       tg->WriteRuleFiles();
       gg->RecordTargetProgress(tg.get());
+      gg->RecordTargetDependStep(tg.get());
       }
     }
 
@@ -1291,7 +1292,8 @@ cmLocalUnixMakefileGenerator3
 void
 cmLocalUnixMakefileGenerator3::AppendEcho(std::vector<std::string>& commands,
                                           const char* text,
-                                          EchoColor color)
+                                          EchoColor color,
+                                          EchoProgress const* progress)
 {
   // Choose the color for the text.
   std::string color_name;
@@ -1323,6 +1325,20 @@ cmLocalUnixMakefileGenerator3::AppendEcho(std::vector<std::string>& commands,
     }
 #else
   (void)color;
+
+  // Without cmake_echo_color report progress with a separate command.
+  if(progress)
+    {
+    std::string marks = progress->Arg;
+    cmSystemTools::ReplaceString(marks, ",", " ");
+    std::string cmd = "$(CMAKE_COMMAND) -E cmake_progress_report ";
+    cmd += this->Convert(progress->Dir, cmLocalGenerator::FULL,
+                         cmLocalGenerator::SHELL);
+    cmd += " ";
+    cmd += marks;
+    commands.push_back(cmd);
+    progress = 0;
+    }
 #endif
 
   // Echo one line at a time.
@@ -1337,7 +1353,7 @@ cmLocalUnixMakefileGenerator3::AppendEcho(std::vector<std::string>& commands,
         {
         // Add a command to echo this line.
         std::string cmd;
-        if(color_name.empty())
+        if(color_name.empty() && !progress)
           {
           // Use the native echo command.
           cmd = "@echo ";
@@ -1345,9 +1361,24 @@ cmLocalUnixMakefileGenerator3::AppendEcho(std::vector<std::string>& commands,
           }
         else
           {
-          // Use cmake to echo the text in color.
+          // Use cmake to echo the text in color.  It also reports the
+          // progress so that the rule does not need another process.
           cmd = "@$(CMAKE_COMMAND) -E cmake_echo_color --switch=$(COLOR) ";
           cmd += color_name;
+          if(progress)
+            {
+            cmd += "--progress-dir=";
+            cmd += this->Convert(progress->Dir, cmLocalGenerator::FULL,
+                                 cmLocalGenerator::SHELL);
+            cmd += " --progress-num=";
+            cmd += progress->Arg;
+            cmd += " ";
+            }
+          if(!line.empty() && line[0] == '-')
+            {
+            // Do not let the text be taken for an option.
+            cmd += "-- ";
+            }
           cmd += this->EscapeForShell(line);
           }
         commands.push_back(cmd);
@@ -1356,6 +1387,9 @@ cmLocalUnixMakefileGenerator3::AppendEcho(std::vector<std::string>& commands,
       // Reset the line to emtpy.
       line = "";
 
+      // Progress appears only on the first line.
+      progress = 0;
+
       // Terminate on end-of-string.
       if(*c == '\0')
         {
@@ -1554,6 +1588,15 @@ bool cmLocalUnixMakefileGenerator3::UpdateDependencies(const char* tgtInfo,
                                             validDependencies);
     }
 
+  if(verbose)
+    {
+    cmOStringStream msg;
+    msg << "Checked dependencies with " << ftc->GetNumberOfLookups()
+        << " file time lookups, " << ftc->GetNumberOfQueries()
+        << " of which queried the file system." << std::endl;
+    cmSystemTools::Stdout(msg.str().c_str());
+    }
+
   if(needRescanDependInfo || needRescanDirInfo || needRescanDependencies)
     {
     // The dependencies must be regenerated.
@@ -1990,6 +2033,11 @@ void cmLocalUnixMakefileGenerator3::ClearDependencies(cmMakefile* mf,
     std::string internalDependFile = dir + "/depend.internal";
     cmSystemTools::RemoveFile(internalDependFile.c_str());
     }
+
+  // Remove the include scan results shared by all targets.
+  std::string cacheDir = this->Makefile->GetHomeOutputDirectory();
+  cacheDir += cmake::GetCMakeFilesDirectory();
+  cmDependsC::ClearSharedCache(cacheDir);
 }
 
 
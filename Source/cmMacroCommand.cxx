@@ -13,14 +13,186 @@
 
 #include "cmake.h"
 
+// The recorded definition of a macro.  It is shared by the command
+// and all of its clones so that invoking the macro does not copy it.
+class cmMacroHelperDefinition
+{
+public:
+  cmMacroHelperDefinition(): ReferenceCount(1) {}
+  void Register() { ++this->ReferenceCount; }
+  void UnRegister()
+    {
+    if(--this->ReferenceCount == 0)
+      {
+      delete this;
+      }
+    }
+
+  std::vector<std::string> Args;
+  std::vector<cmListFileFunction> Functions;
+  cmPolicies::PolicyMap Policies;
+  std::string FilePath;
+
+  // A body argument split into literal text and references to the
+  // macro arguments.  An invocation concatenates the pieces instead of
+  // searching the body for every argument reference.
+  struct Piece
+  {
+    enum PieceType { Text, Formal, Count, Rest, All, Positional };
+    Piece(PieceType t, unsigned int i, std::string const& v):
+      Type(t), Index(i), Value(v) {}
+    PieceType Type;
+    unsigned int Index;
+    std::string Value; // The literal text or the reference itself.
+  };
+  struct Template
+  {
+    Template(): Valid(false) {}
+    bool Valid;
+    std::vector<Piece> Pieces;
+  };
+
+  // Templates for the arguments of each function in the body.
+  std::vector<std::vector<Template> > Templates;
+
+  void Compile();
+private:
+  unsigned int ReferenceCount;
+  bool Lookup(std::string const& name, Piece::PieceType& type,
+              unsigned int& index) const;
+  void Compile(std::string const& value, Template& t) const;
+};
+
+//----------------------------------------------------------------------------
+bool cmMacroHelperDefinition::Lookup(std::string const& name,
+                                     Piece::PieceType& type,
+                                     unsigned int& index) const
+{
+  // Match the order in which references are replaced by
+  // cmMacroHelperCommand::InvokeInitialPass.
+  for(unsigned int j = 1; j < this->Args.size(); ++j)
+    {
+    if(name == this->Args[j])
+      {
+      type = Piece::Formal;
+      index = j;
+      return true;
+      }
+    }
+  if(name == "ARGC")
+    {
+    type = Piece::Count;
+    return true;
+    }
+  if(name == "ARGN")
+    {
+    type = Piece::Rest;
+    return true;
+    }
+  if(name == "ARGV")
+    {
+    type = Piece::All;
+    return true;
+    }
+  // Only the canonical spelling of ARGV<n> is replaced.
+  if(name.size() > 4 && name.size() < 14 && name.compare(0, 4, "ARGV") == 0 &&
+     (name[4] != '0' || name.size() == 5) &&
+     name.find_first_not_of("0123456789", 4) == name.npos)
+    {
+    type = Piece::Positional;
+    index = static_cast<unsigned int>(atoi(name.c_str() + 4));
+    return true;
+    }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+void cmMacroHelperDefinition::Compile(std::string const& value,
+                                      Template& t) const
+{
+  std::string::size_type literal = 0;
+  std::string::size_type pos = 0;
+  std::string::size_type i;
+  while((i = value.find("${", pos)) != value.npos)
+    {
+    std::string::size_type j = value.find('}', i + 2);
+    if(j == value.npos)
+      {
+      break;
+      }
+    Piece::PieceType type;
+    unsigned int index = 0;
+    if(!this->Lookup(value.substr(i + 2, j - i - 2), type, index))
+      {
+      pos = i + 1;
+      continue;
+      }
+
+    // A reference nested inside an unterminated "${" may combine with
+    // the surrounding text to form a new reference after replacement.
+    // Leave such arguments to the replacement done one name at a time.
+    if(i > 0)
+      {
+      std::string::size_type open = value.rfind("${", i - 1);
+      std::string::size_type close = value.rfind('}', i - 1);
+      if(open != value.npos && (close == value.npos || open > close))
+        {
+        t.Pieces.clear();
+        return;
+        }
+      }
+
+    if(i > literal)
+      {
+      t.Pieces.push_back(
+        Piece(Piece::Text, 0, value.substr(literal, i - literal)));
+      }
+    t.Pieces.push_back(Piece(type, index, value.substr(i, j + 1 - i)));
+    literal = pos = j + 1;
+    }
+  if(literal < value.size())
+    {
+    t.Pieces.push_back(Piece(Piece::Text, 0, value.substr(literal)));
+    }
+  t.Valid = true;
+}
+
+//----------------------------------------------------------------------------
+void cmMacroHelperDefinition::Compile()
+{
+  // Argument names that could be part of a reference syntax cannot be
+  // replaced in a single pass.
+  for(unsigned int j = 1; j < this->Args.size(); ++j)
+    {
+    if(this->Args[j].find_first_of("${}") != std::string::npos)
+      {
+      return;
+      }
+    }
+  this->Templates.resize(this->Functions.size());
+  for(unsigned int c = 0; c < this->Functions.size(); ++c)
+    {
+    std::vector<cmListFileArgument> const& fargs =
+      this->Functions[c].Arguments;
+    this->Templates[c].resize(fargs.size());
+    for(unsigned int k = 0; k < fargs.size(); ++k)
+      {
+      if(fargs[k].Delim != cmListFileArgument::Bracket)
+        {
+        this->Compile(fargs[k].Value, this->Templates[c][k]);
+        }
+      }
+    }
+}
+
 // define the class for macro commands
 class cmMacroHelperCommand : public cmCommand
 {
 public:
-  cmMacroHelperCommand() {}
+  cmMacroHelperCommand(cmMacroHelperDefinition* def): Definition(def) {}
 
   ///! clean up any memory allocated by the macro
-  ~cmMacroHelperCommand() {}
+  ~cmMacroHelperCommand() { this->Definition->UnRegister(); }
 
   /**
    * This is used to avoid including this command
@@ -38,13 +210,9 @@ public:
    */
   virtual cmCommand* Clone()
   {
-    cmMacroHelperCommand *newC = new cmMacroHelperCommand;
-    // we must copy when we clone
-    newC->Args = this->Args;
-    newC->Functions = this->Functions;
-    newC->FilePath = this->FilePath;
-    newC->Policies = this->Policies;
-    return newC;
+    // The definition is not modified by invocations so share it.
+    this->Definition->Register();
+    return new cmMacroHelperCommand(this->Definition);
   }
 
   /**
@@ -65,14 +233,12 @@ public:
   /**
    * The name of the command as specified in CMakeList.txt.
    */
-  virtual std::string GetName() const { return this->Args[0]; }
+  virtual std::string GetName() const
+    { return this->Definition->Args[0]; }
 
   cmTypeMacro(cmMacroHelperCommand, cmCommand);
 
-  std::vector<std::string> Args;
-  std::vector<cmListFileFunction> Functions;
-  cmPolicies::PolicyMap Policies;
-  std::string FilePath;
+  cmMacroHelperDefinition* Definition;
 };
 
 
@@ -80,6 +246,10 @@ bool cmMacroHelperCommand::InvokeInitialPass
 (const std::vector<cmListFileArgument>& args,
  cmExecutionStatus &inStatus)
 {
+  std::vector<std::string> const& margs = this->Definition->Args;
+  std::vector<cmListFileFunction> const& functions =
+    this->Definition->Functions;
+
   // Expand the argument list to the macro.
   std::vector<std::string> expandedArgs;
   this->Makefile->ExpandArguments(args, expandedArgs);
@@ -90,11 +260,11 @@ bool cmMacroHelperCommand::InvokeInitialPass
 
   // make sure the number of arguments passed is at least the number
   // required by the signature
-  if (expandedArgs.size() < this->Args.size() - 1)
+  if (expandedArgs.size() < margs.size() - 1)
     {
     std::string errorMsg =
       "Macro invoked with incorrect arguments for macro named: ";
-    errorMsg += this->Args[0];
+    errorMsg += margs[0];
     this->SetError(errorMsg);
     return false;
     }
@@ -104,7 +274,8 @@ bool cmMacroHelperCommand::InvokeInitialPass
 
   // Push a weak policy scope which restores the policies recorded at
   // macro creation.
-  cmMakefile::PolicyPushPop polScope(this->Makefile, true, this->Policies);
+  cmMakefile::PolicyPushPop polScope(this->Makefile, true,
+                                     this->Definition->Policies);
 
   // set the value of argc
   cmOStringStream argcDefStream;
@@ -116,42 +287,115 @@ bool cmMacroHelperCommand::InvokeInitialPass
   std::string argnDef;
   bool argnDefInitialized = false;
   bool argvDefInitialized = false;
-  if( this->Functions.size())
+
+  // The compiled templates may be used only if no argument value can
+  // form a new reference together with the text around it.
+  bool useTemplates = !this->Definition->Templates.empty();
+  for(std::vector<std::string>::const_iterator ai = expandedArgs.begin();
+      useTemplates && ai != expandedArgs.end(); ++ai)
     {
-    this->FilePath = this->Functions[0].FilePath;
+    useTemplates = ai->find_first_of("${}") == std::string::npos;
     }
+
   // Invoke all the functions that were collected in the block.
   cmListFileFunction newLFF;
   // for each function
-  for(unsigned int c = 0; c < this->Functions.size(); ++c)
+  for(unsigned int c = 0; c < functions.size(); ++c)
     {
     // Replace the formal arguments and then invoke the command.
     newLFF.Arguments.clear();
-    newLFF.Arguments.reserve(this->Functions[c].Arguments.size());
-    newLFF.Name = this->Functions[c].Name;
-    newLFF.FilePath = this->Functions[c].FilePath;
-    newLFF.Line = this->Functions[c].Line;
+    newLFF.Arguments.reserve(functions[c].Arguments.size());
+    newLFF.Name = functions[c].Name;
+    newLFF.FilePath = functions[c].FilePath;
+    newLFF.Line = functions[c].Line;
+
+    // Resolve the command through the recorded call so the result is
+    // kept for later invocations of the macro.
+    this->Makefile->GetCMakeInstance()->ResolveCommand(functions[c]);
+    newLFF.Command = functions[c].Command;
+    newLFF.CommandGeneration = functions[c].CommandGeneration;
 
     // for each argument of the current function
-    for (std::vector<cmListFileArgument>::iterator k =
-           this->Functions[c].Arguments.begin();
-         k != this->Functions[c].Arguments.end(); ++k)
+    for (std::vector<cmListFileArgument>::const_iterator k =
+           functions[c].Arguments.begin();
+         k != functions[c].Arguments.end(); ++k)
       {
-      // Set the FilePath on the arguments to match the function since it is
-      // not stored and the original values may be freed
-      k->FilePath = this->FilePath.c_str();
+      cmMacroHelperDefinition::Template const* tmpl = 0;
+      if(useTemplates)
+        {
+        tmpl = &this->Definition->Templates[c][k -
+                                            functions[c].Arguments.begin()];
+        }
       if(k->Delim == cmListFileArgument::Bracket)
         {
         arg.Value = k->Value;
         }
+      else if(tmpl && tmpl->Valid)
+        {
+        // Stitch the argument values into the compiled template.
+        arg.Value = "";
+        for(std::vector<cmMacroHelperDefinition::Piece>::const_iterator
+              pi = tmpl->Pieces.begin(); pi != tmpl->Pieces.end(); ++pi)
+          {
+          switch(pi->Type)
+            {
+            case cmMacroHelperDefinition::Piece::Text:
+              arg.Value += pi->Value;
+              break;
+            case cmMacroHelperDefinition::Piece::Formal:
+              arg.Value += expandedArgs[pi->Index-1];
+              break;
+            case cmMacroHelperDefinition::Piece::Count:
+              arg.Value += argcDef;
+              break;
+            case cmMacroHelperDefinition::Piece::Rest:
+              if (!argnDefInitialized)
+                {
+                for(std::vector<std::string>::size_type cnt =
+                      margs.size()-1; cnt < expandedArgs.size(); ++cnt)
+                  {
+                  if ( argnDef.size() > 0 )
+                    {
+                    argnDef += ";";
+                    }
+                  argnDef += expandedArgs[cnt];
+                  }
+                argnDefInitialized = true;
+                }
+              arg.Value += argnDef;
+              break;
+            case cmMacroHelperDefinition::Piece::All:
+              if (!argvDefInitialized)
+                {
+                for(std::vector<std::string>::const_iterator
+                      eit = expandedArgs.begin();
+                    eit != expandedArgs.end(); ++eit)
+                  {
+                  if ( argvDef.size() > 0 )
+                    {
+                    argvDef += ";";
+                    }
+                  argvDef += *eit;
+                  }
+                argvDefInitialized = true;
+                }
+              arg.Value += argvDef;
+              break;
+            case cmMacroHelperDefinition::Piece::Positional:
+              arg.Value += (pi->Index < expandedArgs.size()?
+                            expandedArgs[pi->Index] : pi->Value);
+              break;
+            }
+          }
+        }
       else
         {
         tmps = k->Value;
         // replace formal arguments
-        for (unsigned int j = 1; j < this->Args.size(); ++j)
+        for (unsigned int j = 1; j < margs.size(); ++j)
           {
           variable = "${";
-          variable += this->Args[j];
+          variable += margs[j];
           variable += "}";
           cmSystemTools::ReplaceString(tmps, variable.c_str(),
                                        expandedArgs[j-1].c_str());
@@ -168,7 +412,7 @@ bool cmMacroHelperCommand::InvokeInitialPass
             std::vector<std::string>::size_type cnt = 0;
             for(eit = expandedArgs.begin(); eit != expandedArgs.end(); ++eit)
               {
-              if ( cnt >= this->Args.size()-1 )
+              if ( cnt >= margs.size()-1 )
                 {
                 if ( argnDef.size() > 0 )
                   {
@@ -271,14 +515,31 @@ IsFunctionBlocked(const cmListFileFunction& lff, cmMakefile &mf,
       name += " )";
       mf.AddMacro(this->Args[0].c_str(), name.c_str());
       // create a new command and add it to cmake
-      cmMacroHelperCommand *f = new cmMacroHelperCommand();
+      cmMacroHelperDefinition *f = new cmMacroHelperDefinition();
       f->Args = this->Args;
       f->Functions = this->Functions;
       mf.RecordPolicies(f->Policies);
+
+      // Set the FilePath on the arguments to match the macro since it is
+      // not stored and the original values may be freed
+      if(!f->Functions.empty())
+        {
+        f->FilePath = f->Functions[0].FilePath;
+        }
+      for (unsigned int i = 0; i < f->Functions.size(); ++i)
+        {
+        for (unsigned int j = 0; j < f->Functions[i].Arguments.size(); ++j)
+          {
+          f->Functions[i].Arguments[j].FilePath = f->FilePath.c_str();
+          }
+        }
+
       std::string newName = "_" + this->Args[0];
+      f->Compile();
+
       mf.GetCMakeInstance()->RenameCommand(this->Args[0],
                                            newName);
-      mf.AddCommand(f);
+      mf.AddCommand(new cmMacroHelperCommand(f));
 
       // remove the function blocker now that the macro is defined
       mf.RemoveFunctionBlocker(this, lff);
@@ -158,10 +158,20 @@ cmMakefile::cmMakefile(const cmMakefile& mf): Internal(new Internals)
 //----------------------------------------------------------------------------
 void cmMakefile::Initialize()
 {
-  this->cmDefineRegex.compile("#cmakedefine[ \t]+([A-Za-z_0-9]*)");
-  this->cmDefine01Regex.compile("#cmakedefine01[ \t]+([A-Za-z_0-9]*)");
-  this->cmAtVarRegex.compile("(@[A-Za-z_0-9/.+-]+@)");
-  this->cmNamedCurly.compile("^[A-Za-z0-9/_.+-]+{");
+  // Every directory needs these expressions.  Compile them only once
+  // and copy the compiled programs.
+  static cmsys::RegularExpression const
+    defineRegex("#cmakedefine[ \t]+([A-Za-z_0-9]*)");
+  static cmsys::RegularExpression const
+    define01Regex("#cmakedefine01[ \t]+([A-Za-z_0-9]*)");
+  static cmsys::RegularExpression const
+    atVarRegex("(@[A-Za-z_0-9/.+-]+@)");
+  static cmsys::RegularExpression const
+    namedCurly("^[A-Za-z0-9/_.+-]+{");
+  this->cmDefineRegex = defineRegex;
+  this->cmDefine01Regex = define01Regex;
+  this->cmAtVarRegex = atVarRegex;
+  this->cmNamedCurly = namedCurly;
 
   // Enter a policy level for this directory.
   this->PushPolicy();
@@ -392,14 +402,12 @@ bool cmMakefile::ExecuteCommand(const cmListFileFunction& lff,
     return result;
     }
 
-  std::string name = lff.Name;
-
   // Place this call on the call stack.
   cmMakefileCall stack_manager(this, lff, status);
   static_cast<void>(stack_manager);
 
   // Lookup the command prototype.
-  if(cmCommand* proto = this->GetCMakeInstance()->GetCommand(name))
+  if(cmCommand* proto = this->GetCMakeInstance()->ResolveCommand(lff))
     {
     // Clone the prototype.
     cmsys::auto_ptr<cmCommand> pcmd(proto->Clone());
@@ -1573,7 +1581,8 @@ void cmMakefile::InitializeFromParent()
   cmMakefile *parent = this->LocalGenerator->GetParent()->GetMakefile();
 
   // Initialize definitions with the closure of the parent scope.
-  this->Internal->VarStack.top() = parent->Internal->VarStack.top().Closure();
+  this->Internal->VarStack.top().ResetToClosure(
+    parent->Internal->VarStack.top());
 
   const std::vector<cmValueWithOrigin>& parentIncludes =
                                         parent->GetIncludeDirectoriesEntries();
@@ -1895,6 +1904,12 @@ void cmMakefile::MarkVariableAsUsed(const std::string& var)
   this->Internal->VarUsageStack.top().insert(var);
 }
 
+bool cmMakefile::TrackVariableUsage() const
+{
+  return this->WarnUnused ||
+    this->GetCMakeInstance()->GetWarnUninitialized();
+}
+
 bool cmMakefile::VariableInitialized(const std::string& var) const
 {
   if(this->Internal->VarInitStack.top().find(var) !=
@@ -2557,6 +2572,14 @@ const char *cmMakefile::ExpandVariablesInString(std::string& source,
     return source.c_str();
     }
 
+  // Fast path strings without any special characters.  Neither the
+  // old nor the new evaluation rules change them, so there is no need
+  // to look up the policy setting or run either implementation.
+  if(source.find_first_of(atOnly? "@" : "$@\\") == source.npos)
+    {
+    return source.c_str();
+    }
+
   // Variables used in the WARN case.
   std::string newResult;
   std::string newErrorstr;
@@ -2810,7 +2833,7 @@ cmake::MessageType cmMakefile::ExpandVariablesInStringNew(
   const char* last = in;
   std::string result;
   result.reserve(source.size());
-  std::stack<t_lookup> openstack;
+  std::stack<t_lookup, std::vector<t_lookup> > openstack;
   bool error = false;
   bool done = false;
   openstack.push(t_lookup());
@@ -3315,21 +3338,27 @@ bool cmMakefile::ExpandArguments(
       outArgs.push_back(i->Value);
       continue;
       }
-    // Expand the variables in the argument.
-    value = i->Value;
-    this->ExpandVariablesInString(value, false, false, false,
-                                  i->FilePath, i->Line,
-                                  false, false);
+    // Expand the variables in the argument.  Most arguments contain no
+    // references at all, so use them as written without a copy.
+    std::string const* arg = &i->Value;
+    if(i->Value.find_first_of("$@\\") != i->Value.npos)
+      {
+      value = i->Value;
+      this->ExpandVariablesInString(value, false, false, false,
+                                    i->FilePath, i->Line,
+                                    false, false);
+      arg = &value;
+      }
 
     // If the argument is quoted, it should be one argument.
     // Otherwise, it may be a list of arguments.
     if(i->Delim == cmListFileArgument::Quoted)
       {
-      outArgs.push_back(value);
+      outArgs.push_back(*arg);
       }
     else
       {
-      cmSystemTools::ExpandListArgument(value, outArgs);
+      cmSystemTools::ExpandListArgument(*arg, outArgs);
       }
     }
   return !cmSystemTools::GetFatalErrorOccured();
@@ -3531,6 +3560,9 @@ int cmMakefile::TryCompile(const std::string& srcdir,
   std::string cmakeCommand = this->GetDefinition("CMAKE_COMMAND");
   cmake cm;
   cm.SetIsInTryCompile(true);
+  // Every try_compile project reads the same platform and language
+  // modules.  Share the list files already parsed by this instance.
+  cm.SetListFileCache(this->GetCMakeInstance()->GetListFileCache());
   cmGlobalGenerator *gg = cm.CreateGlobalGenerator
     (this->LocalGenerator->GetGlobalGenerator()->GetName());
   if (!gg)
@@ -4385,15 +4417,32 @@ std::string cmMakefile::GetListFileStack() const
 void cmMakefile::PushScope()
 {
   cmDefinitions* parent = &this->Internal->VarStack.top();
+  this->Internal->VarStack.push(cmDefinitions(parent));
+
+  // The initialization and usage sets are needed only to produce
+  // warnings.  Do not pay for copying them on every function call
+  // otherwise.
+  if(!this->TrackVariableUsage())
+    {
+    this->Internal->VarInitStack.push(std::set<std::string>());
+    this->Internal->VarUsageStack.push(std::set<std::string>());
+    return;
+    }
   const std::set<std::string>& init = this->Internal->VarInitStack.top();
   const std::set<std::string>& usage = this->Internal->VarUsageStack.top();
-  this->Internal->VarStack.push(cmDefinitions(parent));
   this->Internal->VarInitStack.push(init);
   this->Internal->VarUsageStack.push(usage);
 }
 
 void cmMakefile::PopScope()
 {
+  if(!this->TrackVariableUsage())
+    {
+    this->Internal->VarStack.pop();
+    this->Internal->VarInitStack.pop();
+    this->Internal->VarUsageStack.pop();
+    return;
+    }
   cmDefinitions* current = &this->Internal->VarStack.top();
   std::set<std::string> init = this->Internal->VarInitStack.top();
   std::set<std::string> usage = this->Internal->VarUsageStack.top();
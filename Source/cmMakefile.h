@@ -899,6 +899,10 @@ protected:
   // Check for a an unused variable
   void CheckForUnused(const char* reason, const std::string& name) const;
 
+  // Whether variable initialization and usage must be tracked
+  // for --warn-uninitialized or --warn-unused-vars.
+  bool TrackVariableUsage() const;
+
   std::string Prefix;
   std::vector<std::string> AuxSourceDirectories; //
 
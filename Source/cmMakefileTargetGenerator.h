@@ -50,6 +50,9 @@ public:
   std::string GetProgressFileNameFull()
     { return this->ProgressFileNameFull; }
 
+  /* return whether the depend step of the target has anything to do */
+  bool GetNeedDependStep() const { return this->NeedDependStep; }
+
   cmTarget* GetTarget() { return this->Target;}
 
 protected:
@@ -109,7 +112,7 @@ protected:
   void GenerateExtraOutput(const char* out, const char* in,
                            bool symbolic = false);
 
-  void AppendProgress(std::vector<std::string>& commands);
+  void MakeEchoProgress(cmLocalUnixMakefileGenerator3::EchoProgress&) const;
 
   // write out the variable that lists the objects for this target
   void WriteObjectsVariable(std::string& variableName,
@@ -201,6 +204,9 @@ protected:
   unsigned long NumberOfProgressActions;
   bool NoRuleMessages;
 
+  // whether the depend rule has any commands or dependencies
+  bool NeedDependStep;
+
   // the path to the directory the build file is in
   std::string TargetBuildDirectory;
   std::string TargetBuildDirectoryFull;
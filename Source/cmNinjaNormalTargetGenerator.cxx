@@ -445,6 +445,12 @@ void cmNinjaNormalTargetGenerator::WriteLinkStatement()
   cmNinjaDeps explicitDeps = this->GetObjects();
   cmNinjaDeps implicitDeps = this->ComputeLinkDeps();
 
+  // Link after all target dependencies are complete.  The objects are
+  // only ordered after the steps of the dependencies that they need.
+  cmNinjaDeps orderOnlyDeps;
+  this->GetLocalGenerator()->AppendTargetDepends(this->GetTarget(),
+                                                 orderOnlyDeps);
+
   cmMakefile* mf = this->GetMakefile();
 
   std::string frameworkPath;
@@ -615,7 +621,7 @@ void cmNinjaNormalTargetGenerator::WriteLinkStatement()
                         outputs,
                         explicitDeps,
                         implicitDeps,
-                        emptyDeps,
+                        orderOnlyDeps,
                         vars,
                         rspfile,
                         commandLineLengthLimit);
@@ -681,11 +687,16 @@ void cmNinjaNormalTargetGenerator::WriteObjectLibStatement()
   cmNinjaDeps outputs;
   this->GetLocalGenerator()->AppendTargetOutputs(this->GetTarget(), outputs);
   cmNinjaDeps depends = this->GetObjects();
+  cmNinjaDeps orderOnlyDeps;
+  this->GetLocalGenerator()->AppendTargetDepends(this->GetTarget(),
+                                                 orderOnlyDeps);
   this->GetGlobalGenerator()->WritePhonyBuild(this->GetBuildFileStream(),
                                               "Object library "
                                                 + this->GetTargetName(),
                                               outputs,
-                                              depends);
+                                              depends,
+                                              cmNinjaDeps(),
+                                              orderOnlyDeps);
 
   // Add aliases for the target name.
   this->GetGlobalGenerator()->AddTargetAlias(this->GetTargetName(),
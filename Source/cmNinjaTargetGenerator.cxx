@@ -124,7 +124,7 @@ void cmNinjaTargetGenerator::AddFeatureFlags(std::string& flags,
 std::string
 cmNinjaTargetGenerator::OrderDependsTargetForTarget()
 {
-  return "cmake_order_depends_target_" + this->GetTargetName();
+  return cmGlobalNinjaGenerator::OrderDependsTargetForTarget(this->Target);
 }
 
 // TODO: Most of the code is picked up from
@@ -524,7 +524,8 @@ cmNinjaTargetGenerator
     }
 
   cmNinjaDeps orderOnlyDeps;
-  this->GetLocalGenerator()->AppendTargetDepends(this->Target, orderOnlyDeps);
+  this->GetLocalGenerator()->AppendTargetOrderDepends(this->Target,
+                                                      orderOnlyDeps);
 
   // Add order-only dependencies on custom command outputs.
   for(std::vector<cmCustomCommand const*>::const_iterator
@@ -604,6 +605,8 @@ cmNinjaTargetGenerator
   // will rebuild the file.
   if (source->GetPropertyAsBool("GENERATED") && !source->GetCustomCommand() &&
       !this->GetGlobalGenerator()->HasCustomCommandOutput(sourceFileName)) {
+    this->GetLocalGenerator()->AppendTargetDepends(this->Target,
+                                                   orderOnlyDeps);
     this->GetGlobalGenerator()->AddAssumedSourceDependencies(sourceFileName,
                                                              orderOnlyDeps);
   }
@@ -117,6 +117,15 @@ public:
   typedef std::map<TargetConfigPair, OptionalLinkInterface>
                                                           LinkInterfaceMapType;
   LinkInterfaceMapType LinkInterfaceMap;
+
+  // The head for which the link interface of each configuration was
+  // computed without depending on it, so that all heads may share it.
+  typedef std::map<std::string, cmTarget const*> SharedLinkInterfaceMapType;
+  SharedLinkInterfaceMapType SharedLinkInterfaceMap;
+  OptionalLinkInterface* GetSharedLinkInterface(const std::string& config,
+                                                bool complete);
+  void ShareLinkInterface(TargetConfigPair const& key,
+                          OptionalLinkInterface const& iface);
   bool PolicyWarnedCMP0022;
 
   typedef std::map<std::string, cmTarget::OutputInfo> OutputInfoMapType;
@@ -174,6 +183,13 @@ public:
   mutable std::map<std::string, bool> CacheLinkInterfaceCompileOptionsDone;
   mutable std::map<std::string, bool> CacheLinkInterfaceSourcesDone;
   mutable std::map<std::string, bool> CacheLinkInterfaceCompileFeaturesDone;
+
+  // Usage requirements evaluated for each configuration while generating.
+  typedef std::map<std::string, std::vector<std::string> >
+                                                    UsageRequirementsMapType;
+  mutable UsageRequirementsMapType CachedIncludeDirectories;
+  mutable UsageRequirementsMapType CachedCompileOptions;
+  mutable UsageRequirementsMapType CachedCompileDefinitions;
 };
 
 //----------------------------------------------------------------------------
@@ -474,6 +490,7 @@ void cmTarget::ClearLinkMaps()
   this->LinkImplementationLanguageIsContextDependent = true;
   this->Internal->LinkImplMap.clear();
   this->Internal->LinkInterfaceMap.clear();
+  this->Internal->SharedLinkInterfaceMap.clear();
   this->Internal->LinkClosureMap.clear();
   for (cmTargetLinkInformationMap::const_iterator it
       = this->LinkInformation.begin();
@@ -1195,10 +1212,21 @@ bool cmTarget::NameResolvesToFramework(const std::string& libname) const
     NameResolvesToFramework(libname);
 }
 
+//----------------------------------------------------------------------------
+static bool
+linkLibrariesDependOnHead(cmCompiledGeneratorExpression const* cge)
+{
+  // Any property or other target looked at may lead back to the head.
+  return cge->GetHadContextSensitiveCondition()
+      || !cge->GetSeenTargetProperties().empty()
+      || !cge->GetAllTargetsSeen().empty();
+}
+
 //----------------------------------------------------------------------------
 void cmTarget::GetDirectLinkLibraries(const std::string& config,
                             std::vector<std::string> &libs,
-                            cmTarget const* head) const
+                            cmTarget const* head,
+                            bool* hadHeadSensitiveCondition) const
 {
   const char *prop = this->GetProperty("LINK_LIBRARIES");
   if (prop)
@@ -1226,6 +1254,10 @@ void cmTarget::GetDirectLinkLibraries(const std::string& config,
         this->LinkImplicitNullProperties.insert(*it);
         }
       }
+    if (hadHeadSensitiveCondition)
+      {
+      *hadHeadSensitiveCondition = linkLibrariesDependOnHead(cge.get());
+      }
     }
 }
 
@@ -2059,6 +2091,46 @@ void cmTarget::InsertCompileDefinition(const cmValueWithOrigin &entry)
       new cmTargetInternals::TargetPropertyEntry(ge.Parse(entry.Value)));
 }
 
+//----------------------------------------------------------------------------
+static bool
+findCachedUsageRequirements(cmTarget const* tgt,
+                     cmTargetInternals::UsageRequirementsMapType const& cache,
+                     const std::string& config,
+                     std::vector<std::string>& result)
+{
+  // The properties of targets do not change while generating, so
+  // usage requirements evaluated once may be used again.
+  cmMakefile* mf = tgt->GetMakefile();
+  if (!mf->IsGeneratingBuildSystem())
+    {
+    return false;
+    }
+  cmTargetInternals::UsageRequirementsMapType::const_iterator it =
+                                                        cache.find(config);
+  bool found = it != cache.end();
+  mf->GetLocalGenerator()->GetGlobalGenerator()
+                          ->CountUsageRequirementsLookup(found);
+  if (found)
+    {
+    result.insert(result.end(), it->second.begin(), it->second.end());
+    }
+  return found;
+}
+
+//----------------------------------------------------------------------------
+static void
+storeCachedUsageRequirements(cmTarget const* tgt,
+                     cmTargetInternals::UsageRequirementsMapType& cache,
+                     const std::string& config,
+                     std::vector<std::string> const& result,
+                     std::vector<std::string>::size_type start)
+{
+  if (tgt->GetMakefile()->IsGeneratingBuildSystem())
+    {
+    cache[config].assign(result.begin() + start, result.end());
+    }
+}
+
 //----------------------------------------------------------------------------
 static void processIncludeDirectories(cmTarget const* tgt,
       const std::vector<cmTargetInternals::TargetPropertyEntry*> &entries,
@@ -2233,6 +2305,12 @@ std::vector<std::string>
 cmTarget::GetIncludeDirectories(const std::string& config) const
 {
   std::vector<std::string> includes;
+  if (findCachedUsageRequirements(this,
+                                  this->Internal->CachedIncludeDirectories,
+                                  config, includes))
+    {
+    return includes;
+    }
   std::set<std::string> uniqueIncludes;
   cmListFileBacktrace lfbt;
 
@@ -2357,6 +2435,9 @@ cmTarget::GetIncludeDirectories(const std::string& config) const
                                                                       = true;
     }
 
+  storeCachedUsageRequirements(this,
+                               this->Internal->CachedIncludeDirectories,
+                               config, includes, 0);
   return includes;
 }
 
@@ -2461,6 +2542,13 @@ void cmTarget::GetAutoUicOptions(std::vector<std::string> &result,
 void cmTarget::GetCompileOptions(std::vector<std::string> &result,
                                  const std::string& config) const
 {
+  if (findCachedUsageRequirements(this,
+                                  this->Internal->CachedCompileOptions,
+                                  config, result))
+    {
+    return;
+    }
+  std::vector<std::string>::size_type start = result.size();
   std::set<std::string> uniqueOptions;
   cmListFileBacktrace lfbt;
 
@@ -2554,6 +2642,10 @@ void cmTarget::GetCompileOptions(std::vector<std::string> &result,
     {
     this->Internal->CacheLinkInterfaceCompileOptionsDone[config] = true;
     }
+
+  storeCachedUsageRequirements(this,
+                               this->Internal->CachedCompileOptions,
+                               config, result, start);
 }
 
 //----------------------------------------------------------------------------
@@ -2573,6 +2665,13 @@ static void processCompileDefinitions(cmTarget const* tgt,
 void cmTarget::GetCompileDefinitions(std::vector<std::string> &list,
                                             const std::string& config) const
 {
+  if (findCachedUsageRequirements(this,
+                                  this->Internal->CachedCompileDefinitions,
+                                  config, list))
+    {
+    return;
+    }
+  std::vector<std::string>::size_type start = list.size();
   std::set<std::string> uniqueOptions;
   cmListFileBacktrace lfbt;
 
@@ -2703,6 +2802,10 @@ void cmTarget::GetCompileDefinitions(std::vector<std::string> &list,
     this->Internal->CacheLinkInterfaceCompileDefinitionsDone[config]
                                                                       = true;
     }
+
+  storeCachedUsageRequirements(this,
+                               this->Internal->CachedCompileDefinitions,
+                               config, list, start);
 }
 
 //----------------------------------------------------------------------------
@@ -6084,6 +6187,14 @@ cmTarget::LinkInterface const* cmTarget::GetLinkInterface(
     i = this->Internal->LinkInterfaceMap.find(key);
   if(i == this->Internal->LinkInterfaceMap.end())
     {
+    // Use the link interface computed for another head if it did not
+    // depend on that head.
+    if(cmTargetInternals::OptionalLinkInterface const* shared =
+       this->Internal->GetSharedLinkInterface(key.second, true))
+      {
+      return shared->Exists ? shared : 0;
+      }
+
     // Compute the link interface for this configuration.
     cmTargetInternals::OptionalLinkInterface iface;
     iface.ExplicitLibraries =
@@ -6097,6 +6208,7 @@ cmTarget::LinkInterface const* cmTarget::GetLinkInterface(
     // Store the information for this configuration.
     cmTargetInternals::LinkInterfaceMapType::value_type entry(key, iface);
     i = this->Internal->LinkInterfaceMap.insert(entry).first;
+    this->Internal->ShareLinkInterface(key, i->second);
     }
   else if(!i->second.Complete && i->second.Exists)
     {
@@ -6137,6 +6249,12 @@ cmTarget::GetLinkInterfaceLibraries(const std::string& config,
     i = this->Internal->LinkInterfaceMap.find(key);
   if(i == this->Internal->LinkInterfaceMap.end())
     {
+    if(cmTargetInternals::OptionalLinkInterface const* shared =
+       this->Internal->GetSharedLinkInterface(key.second, false))
+      {
+      return shared->Exists ? shared : 0;
+      }
+
     // Compute the link interface for this configuration.
     cmTargetInternals::OptionalLinkInterface iface;
     iface.ExplicitLibraries = this->ComputeLinkInterfaceLibraries(config,
@@ -6147,11 +6265,53 @@ cmTarget::GetLinkInterfaceLibraries(const std::string& config,
     // Store the information for this configuration.
     cmTargetInternals::LinkInterfaceMapType::value_type entry(key, iface);
     i = this->Internal->LinkInterfaceMap.insert(entry).first;
+    this->Internal->ShareLinkInterface(key, i->second);
     }
 
   return i->second.Exists ? &i->second : 0;
 }
 
+//----------------------------------------------------------------------------
+cmTargetInternals::OptionalLinkInterface*
+cmTargetInternals::GetSharedLinkInterface(const std::string& config,
+                                          bool complete)
+{
+  SharedLinkInterfaceMapType::const_iterator i =
+    this->SharedLinkInterfaceMap.find(config);
+  if(i == this->SharedLinkInterfaceMap.end())
+    {
+    return 0;
+    }
+  LinkInterfaceMapType::iterator li =
+    this->LinkInterfaceMap.find(TargetConfigPair(i->second, config));
+  if(li == this->LinkInterfaceMap.end())
+    {
+    return 0;
+    }
+  OptionalLinkInterface* iface = &li->second;
+
+  // Completing the interface may have found it to depend on the head
+  // after it was shared.  An incomplete interface is never completed
+  // on behalf of another head.
+  if(iface->HadHeadSensitiveCondition
+     || (complete && iface->Exists && !iface->Complete))
+    {
+    return 0;
+    }
+  return iface;
+}
+
+//----------------------------------------------------------------------------
+void cmTargetInternals::ShareLinkInterface(TargetConfigPair const& key,
+                                           OptionalLinkInterface const& iface)
+{
+  if(!iface.HadHeadSensitiveCondition
+     && !this->GetSharedLinkInterface(key.second, false))
+    {
+    this->SharedLinkInterfaceMap[key.second] = key.first;
+    }
+}
+
 //----------------------------------------------------------------------------
 void processILibs(const std::string& config,
                   cmTarget const* headTarget,
@@ -6349,12 +6509,15 @@ const char* cmTarget::ComputeLinkInterfaceLibraries(const std::string& config,
     cmGeneratorExpression ge(lfbt);
     cmGeneratorExpressionDAGChecker dagChecker(lfbt, this->GetName(),
                                                linkIfaceProp, 0, 0);
-    cmSystemTools::ExpandListArgument(ge.Parse(explicitLibraries)->Evaluate(
+    cmsys::auto_ptr<cmCompiledGeneratorExpression> cge =
+                                                ge.Parse(explicitLibraries);
+    cmSystemTools::ExpandListArgument(cge->Evaluate(
                                         this->Makefile,
                                         config,
                                         false,
                                         headTarget,
                                         this, &dagChecker), iface.Libraries);
+    iface.HadHeadSensitiveCondition = linkLibrariesDependOnHead(cge.get());
     }
   else if (this->PolicyStatusCMP0022 == cmPolicies::WARN
         || this->PolicyStatusCMP0022 == cmPolicies::OLD)
@@ -6367,6 +6530,7 @@ const char* cmTarget::ComputeLinkInterfaceLibraries(const std::string& config,
     LinkImplementation const* impl =
         this->GetLinkImplementationLibraries(config, headTarget);
     iface.Libraries = impl->Libraries;
+    iface.HadHeadSensitiveCondition = impl->HadHeadSensitiveCondition;
     if(this->PolicyStatusCMP0022 == cmPolicies::WARN &&
        !this->Internal->PolicyWarnedCMP0022)
       {
@@ -6459,6 +6623,10 @@ void cmTargetInternals::ComputeLinkInterface(cmTarget const* thisTarget,
         {
         cmTarget::LinkImplementation const* impl =
             thisTarget->GetLinkImplementation(config, headTarget);
+        if(impl->HadHeadSensitiveCondition)
+          {
+          iface.HadHeadSensitiveCondition = true;
+          }
         for(std::vector<std::string>::const_iterator
               li = impl->Libraries.begin(); li != impl->Libraries.end(); ++li)
           {
@@ -6495,6 +6663,10 @@ void cmTargetInternals::ComputeLinkInterface(cmTarget const* thisTarget,
     // The link implementation is the default link interface.
     cmTarget::LinkImplementation const*
                 impl = thisTarget->GetLinkImplementation(config, headTarget);
+    if(impl->HadHeadSensitiveCondition)
+      {
+      iface.HadHeadSensitiveCondition = true;
+      }
     iface.ImplementationIsInterface = true;
     iface.WrongConfigLibraries = impl->WrongConfigLibraries;
     if(thisTarget->LinkLanguagePropagatesToDependents())
@@ -6556,6 +6728,10 @@ cmTarget::GetLinkImplementation(const std::string& config,
     LinkImplementation impl;
     this->ComputeLinkImplementation(config, impl, head);
     this->ComputeLinkImplementationLanguages(config, impl, head);
+    if(this->LinkImplementationLanguageIsContextDependent)
+      {
+      impl.HadHeadSensitiveCondition = true;
+      }
 
     // Store the information for this configuration.
     cmTargetInternals::LinkImplMapType::value_type entry(key, impl);
@@ -6564,6 +6740,10 @@ cmTarget::GetLinkImplementation(const std::string& config,
   else if (i->second.Languages.empty())
     {
     this->ComputeLinkImplementationLanguages(config, i->second, head);
+    if(this->LinkImplementationLanguageIsContextDependent)
+      {
+      i->second.HadHeadSensitiveCondition = true;
+      }
     }
 
   return &i->second;
@@ -6606,7 +6786,8 @@ void cmTarget::ComputeLinkImplementation(const std::string& config,
 {
   // Collect libraries directly linked in this configuration.
   std::vector<std::string> llibs;
-  this->GetDirectLinkLibraries(config, llibs, head);
+  this->GetDirectLinkLibraries(config, llibs, head,
+                               &impl.HadHeadSensitiveCondition);
   for(std::vector<std::string>::const_iterator li = llibs.begin();
       li != llibs.end(); ++li)
     {
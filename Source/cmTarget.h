@@ -161,7 +161,8 @@ public:
     {return this->OriginalLinkLibraries;}
   void GetDirectLinkLibraries(const std::string& config,
                               std::vector<std::string> &,
-                              cmTarget const* head) const;
+                              cmTarget const* head,
+                              bool* hadHeadSensitiveCondition = 0) const;
   void GetInterfaceLinkLibraries(const std::string& config,
                               std::vector<std::string> &,
                               cmTarget const* head) const;
@@ -266,7 +267,12 @@ public:
 
     bool ImplementationIsInterface;
 
-    LinkInterface(): Multiplicity(0), ImplementationIsInterface(false) {}
+    // Whether the interface was computed from anything that depends on
+    // the head target, so it may not be shared with other heads.
+    bool HadHeadSensitiveCondition;
+
+    LinkInterface(): Multiplicity(0), ImplementationIsInterface(false),
+      HadHeadSensitiveCondition(false) {}
   };
 
   /** Get the link interface for the given configuration.  Returns 0
@@ -295,6 +301,11 @@ public:
     // Libraries linked directly in other configurations.
     // Needed only for OLD behavior of CMP0003.
     std::vector<std::string> WrongConfigLibraries;
+
+    // Whether the implementation depends on the head target.
+    bool HadHeadSensitiveCondition;
+
+    LinkImplementation(): HadHeadSensitiveCondition(false) {}
   };
   LinkImplementation const* GetLinkImplementation(const std::string& config,
                                                   cmTarget const* head) const;
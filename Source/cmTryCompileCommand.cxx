@@ -28,7 +28,9 @@ bool cmTryCompileCommand
     return false;
     }
 
+  this->ResultCacheContext = "try_compile";
   this->TryCompileCode(argv);
+  this->SaveResultCache();
 
   // if They specified clean then we clean up what we can
   if (this->SrcFileSignature)
@@ -134,21 +134,38 @@ bool cmTryRunCommand
   this->RunResultVariable = argv[0];
   this->CompileResultVariable = argv[1];
 
+  // The run result depends on the arguments too.  Nothing is run when
+  // cross compiling so there is nothing to store then.
+  this->ResultCacheContext = "";
+  if (!this->Makefile->IsOn("CMAKE_CROSSCOMPILING"))
+    {
+    this->ResultCacheContext = "try_run" + runArgs;
+    }
+
   // do the try compile
   int res = this->TryCompileCode(tryCompile);
 
   // now try running the command if it compiled
   if (!res)
     {
-    if (this->OutputFile.size() == 0)
+    if (this->OutputFile.size() == 0 && !this->ResultFromCache)
       {
       cmSystemTools::Error(this->FindErrorMessage.c_str());
+      this->ResultCacheFile = "";
       }
     else
       {
       // "run" it and capture the output
       std::string runOutputContents;
-      if (this->Makefile->IsOn("CMAKE_CROSSCOMPILING"))
+      if (this->ResultFromCache)
+        {
+        this->Makefile->AddCacheDefinition(this->RunResultVariable,
+                                 this->ResultCacheFields["RUN_RESULT"].c_str(),
+                                           "Result of TRY_RUN",
+                                           cmCacheManager::INTERNAL);
+        runOutputContents = this->ResultCacheFields["RUN_OUTPUT"];
+        }
+      else if (this->Makefile->IsOn("CMAKE_CROSSCOMPILING"))
         {
         this->DoNotRunExecutable(runArgs,
                                  argv[3],
@@ -157,6 +174,9 @@ bool cmTryRunCommand
       else
         {
         this->RunExecutable(runArgs, &runOutputContents);
+        this->ResultCacheFields["RUN_RESULT"] =
+          this->Makefile->GetSafeDefinition(this->RunResultVariable);
+        this->ResultCacheFields["RUN_OUTPUT"] = runOutputContents;
         }
 
       // now put the output into the variables
@@ -182,6 +202,8 @@ bool cmTryRunCommand
       }
     }
 
+  this->SaveResultCache();
+
   // if we created a directory etc, then cleanup after ourselves
   if(!this->Makefile->GetCMakeInstance()->GetDebugTryCompile())
     {
@@ -17,6 +17,7 @@
 #include "cmCommands.h"
 #include "cmCommand.h"
 #include "cmFileTimeComparison.h"
+#include "cmListFileCache.h"
 #include "cmSourceFile.h"
 #include "cmTest.h"
 #include "cmDocumentationFormatter.h"
@@ -125,6 +126,8 @@ cmake::cmake()
   this->DebugTryCompile = false;
   this->ClearBuildSystem = false;
   this->FileComparison = new cmFileTimeComparison;
+  this->ListFileCache = new cmListFileCache;
+  this->OwnListFileCache = true;
 
   this->Policies = new cmPolicies();
   this->InitializeProperties();
@@ -184,6 +187,21 @@ cmake::~cmake()
   delete this->VariableWatch;
 #endif
   delete this->FileComparison;
+  if(this->OwnListFileCache)
+    {
+    delete this->ListFileCache;
+    }
+}
+
+//----------------------------------------------------------------------------
+void cmake::SetListFileCache(cmListFileCache* cache)
+{
+  if(this->OwnListFileCache)
+    {
+    delete this->ListFileCache;
+    }
+  this->ListFileCache = cache;
+  this->OwnListFileCache = false;
 }
 
 void cmake::InitializeProperties()
@@ -200,6 +218,7 @@ void cmake::InitializeProperties()
 
 void cmake::CleanupCommandsAndMacros()
 {
+  ++cmake::CommandGeneration;
   this->InitializeProperties();
   std::vector<cmCommand*> commands;
   for(RegisteredCommandsMap::iterator j = this->Commands.begin();
@@ -230,6 +249,18 @@ bool cmake::CommandExists(const std::string& name) const
   return (this->Commands.find(sName) != this->Commands.end());
 }
 
+unsigned long cmake::CommandGeneration = 1;
+
+cmCommand *cmake::ResolveCommand(cmListFileFunction const& lff)
+{
+  if(lff.CommandGeneration != cmake::CommandGeneration)
+    {
+    lff.Command = this->GetCommand(lff.Name);
+    lff.CommandGeneration = cmake::CommandGeneration;
+    }
+  return lff.Command;
+}
+
 cmCommand *cmake::GetCommand(const std::string& name)
 {
   cmCommand* rm = 0;
@@ -245,6 +276,7 @@ cmCommand *cmake::GetCommand(const std::string& name)
 void cmake::RenameCommand(const std::string& oldName,
                           const std::string& newName)
 {
+  ++cmake::CommandGeneration;
   // if the command already exists, free the old one
   std::string sOldName = cmSystemTools::LowerCase(oldName);
   std::string sNewName = cmSystemTools::LowerCase(newName);
@@ -268,6 +300,7 @@ void cmake::RenameCommand(const std::string& oldName,
 
 void cmake::RemoveCommand(const std::string& name)
 {
+  ++cmake::CommandGeneration;
   std::string sName = cmSystemTools::LowerCase(name);
   RegisteredCommandsMap::iterator pos = this->Commands.find(sName);
   if ( pos != this->Commands.end() )
@@ -279,6 +312,7 @@ void cmake::RemoveCommand(const std::string& name)
 
 void cmake::AddCommand(cmCommand* wg)
 {
+  ++cmake::CommandGeneration;
   std::string name = cmSystemTools::LowerCase(wg->GetName());
   // if the command already exists, free the old one
   RegisteredCommandsMap::iterator pos = this->Commands.find(name);
@@ -1480,6 +1514,17 @@ int cmake::ActualConfigure()
     this->TruncateOutputLog("CMakeError.log");
     }
 
+  // Load list files parsed by the previous run so that unchanged
+  // files need not be parsed again.
+  std::string listFileCache;
+  if(this->GetWorkingMode() == NORMAL_MODE && !this->InTryCompile)
+    {
+    listFileCache = this->GetHomeOutputDirectory();
+    listFileCache += this->GetCMakeFilesDirectory();
+    listFileCache += "/cmake.listfile.cache";
+    this->ListFileCache->Load(listFileCache);
+    }
+
   // actually do the configure
   this->GlobalGenerator->Configure();
   // Before saving the cache
@@ -1553,6 +1598,10 @@ int cmake::ActualConfigure()
     {
     return -1;
     }
+  if(!listFileCache.empty())
+    {
+    this->ListFileCache->Save(listFileCache);
+    }
   return 0;
 }
 
@@ -25,12 +25,14 @@ class cmMakefile;
 class cmCommand;
 class cmVariableWatch;
 class cmFileTimeComparison;
+class cmListFileCache;
 class cmExternalMakefileProjectGenerator;
 class cmDocumentationSection;
 class cmPolicies;
 class cmListFileBacktrace;
 class cmTarget;
 class cmGeneratedFileStream;
+struct cmListFileFunction;
 
 /** \brief Represents a cmake invocation.
  *
@@ -227,6 +229,12 @@ class cmake
    */
   cmCommand *GetCommand(const std::string& name);
 
+  /**
+   * Get the command invoked by a function call.  The result is stored
+   * in the call and reused until a command is added, renamed or removed.
+   */
+  cmCommand *ResolveCommand(cmListFileFunction const& lff);
+
   /** Get list of all commands */
   RegisteredCommandsMap* GetCommands() { return &this->Commands; }
 
@@ -300,6 +308,13 @@ class cmake
    */
   cmFileTimeComparison* GetFileComparison() { return this->FileComparison; }
 
+  /** Get the cache of parsed list files.  */
+  cmListFileCache* GetListFileCache() { return this->ListFileCache; }
+
+  /** Use the cache of parsed list files of another instance.  That
+      instance must outlive this one.  */
+  void SetListFileCache(cmListFileCache* cache);
+
   // Do we want debug output during the cmake run.
   bool GetDebugOutput() { return this->DebugOutput; }
   void SetDebugOutputOn(bool b) { this->DebugOutput = b;}
@@ -375,6 +390,8 @@ protected:
                 CreateExtraGeneratorFunctionType> RegisteredExtraGeneratorsMap;
   typedef std::vector<cmGlobalGeneratorFactory*> RegisteredGeneratorsVector;
   RegisteredCommandsMap Commands;
+  // Incremented whenever any instance changes its command table.
+  static unsigned long CommandGeneration;
   RegisteredGeneratorsVector Generators;
   RegisteredExtraGeneratorsMap ExtraGenerators;
   void AddDefaultCommands();
@@ -443,6 +460,8 @@ private:
   bool ClearBuildSystem;
   bool DebugTryCompile;
   cmFileTimeComparison* FileComparison;
+  cmListFileCache* ListFileCache;
+  bool OwnListFileCache;
   std::string GraphVizFile;
   std::vector<std::string> DebugConfigs;
 
@@ -438,48 +438,8 @@ int cmcmd::ExecuteCMakeCommand(std::vector<std::string>& args)
     // Command to report progress for a build
     else if (args[1] == "cmake_progress_report" && args.size() >= 3)
       {
-      std::string dirName = args[2];
-      dirName += "/Progress";
-      std::string fName;
-      FILE *progFile;
-
-      // read the count
-      fName = dirName;
-      fName += "/count.txt";
-      progFile = cmsys::SystemTools::Fopen(fName.c_str(),"r");
-      int count = 0;
-      if (!progFile)
-        {
-        return 0;
-        }
-      else
-        {
-        if (1!=fscanf(progFile,"%i",&count))
-          {
-          cmSystemTools::Message("Could not read from progress file.");
-          }
-        fclose(progFile);
-        }
-      unsigned int i;
-      for (i = 3; i < args.size(); ++i)
-        {
-        fName = dirName;
-        fName += "/";
-        fName += args[i];
-        progFile = cmsys::SystemTools::Fopen(fName.c_str(),"w");
-        if (progFile)
-          {
-          fprintf(progFile,"empty");
-          fclose(progFile);
-          }
-        }
-      int fileNum = static_cast<int>
-        (cmsys::Directory::GetNumberOfFilesInDirectory(dirName.c_str()));
-      if (count > 0)
-        {
-        // print the progress
-        fprintf(stdout,"[%3i%%] ",((fileNum-3)*100)/count);
-        }
+      std::vector<std::string> marks(args.begin() + 3, args.end());
+      cmcmd::ReportProgress(args[2], marks);
       return 0;
       }
 
@@ -847,6 +807,53 @@ bool cmcmd::SymlinkInternal(std::string const& file, std::string const& link)
 }
 
 //----------------------------------------------------------------------------
+void cmcmd::ReportProgress(std::string const& dir,
+                           std::vector<std::string> const& marks)
+{
+  std::string dirName = dir;
+  dirName += "/Progress";
+  std::string fName;
+  FILE *progFile;
+
+  // read the count
+  fName = dirName;
+  fName += "/count.txt";
+  progFile = cmsys::SystemTools::Fopen(fName.c_str(),"r");
+  int count = 0;
+  if (!progFile)
+    {
+    return;
+    }
+  else
+    {
+    if (1!=fscanf(progFile,"%i",&count))
+      {
+      cmSystemTools::Message("Could not read from progress file.");
+      }
+    fclose(progFile);
+    }
+  for (std::vector<std::string>::const_iterator i = marks.begin();
+       i != marks.end(); ++i)
+    {
+    fName = dirName;
+    fName += "/";
+    fName += *i;
+    progFile = cmsys::SystemTools::Fopen(fName.c_str(),"w");
+    if (progFile)
+      {
+      fprintf(progFile,"empty");
+      fclose(progFile);
+      }
+    }
+  int fileNum = static_cast<int>
+    (cmsys::Directory::GetNumberOfFilesInDirectory(dirName.c_str()));
+  if (count > 0)
+    {
+    // print the progress
+    fprintf(stdout,"[%3i%%] ",((fileNum-3)*100)/count);
+    }
+}
+
 #ifdef CMAKE_BUILD_WITH_CMAKE
 int cmcmd::ExecuteEchoColor(std::vector<std::string>& args)
 {
@@ -857,6 +864,7 @@ int cmcmd::ExecuteEchoColor(std::vector<std::string>& args)
   bool enabled = true;
   int color = cmsysTerminal_Color_Normal;
   bool newline = true;
+  std::string progressDir;
   for(unsigned int i=2; i < args.size(); ++i)
     {
     if(args[i].find("--switch=") == 0)
@@ -875,6 +883,22 @@ int cmcmd::ExecuteEchoColor(std::vector<std::string>& args)
           }
         }
       }
+    else if(args[i].find("--progress-dir=") == 0)
+      {
+      progressDir = args[i].substr(15);
+      }
+    else if(args[i].find("--progress-num=") == 0)
+      {
+      // Report progress before the message so that a rule needs
+      // only one process to do both.
+      std::string const value = args[i].substr(15);
+      std::vector<std::string> marks;
+      if(!value.empty())
+        {
+        marks = cmSystemTools::tokenize(value, ",");
+        }
+      cmcmd::ReportProgress(progressDir, marks);
+      }
     else if(args[i] == "--normal")
       {
       color = cmsysTerminal_Color_Normal;
@@ -923,6 +947,16 @@ int cmcmd::ExecuteEchoColor(std::vector<std::string>& args)
       {
       newline = true;
       }
+    else if(args[i] == "--")
+      {
+      // Print the remaining arguments as text even if they look like
+      // options.
+      for(++i; i < args.size(); ++i)
+        {
+        cmSystemTools::MakefileColorEcho(color, args[i].c_str(),
+                                         newline, enabled);
+        }
+      }
     else
       {
       // Color is enabled.  Print with the current color.
@@ -31,6 +31,8 @@ protected:
   static bool SymlinkInternal(std::string const& file,
                               std::string const& link);
   static int ExecuteEchoColor(std::vector<std::string>& args);
+  static void ReportProgress(std::string const& dir,
+                             std::vector<std::string> const& marks);
   static int ExecuteLinkScript(std::vector<std::string>& args);
   static int WindowsCEEnvironment(const char* version,
                                   const std::string& name);
@@ -0,0 +1,105 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2000-2014 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+#include "cmake.h"
+#include "cmGlobalGenerator.h"
+#include "cmLocalGenerator.h"
+#include "cmMakefile.h"
+#include "cmSystemTools.h"
+
+#include <stdlib.h>
+
+// Time the expansion of command arguments the way list files use
+// them: most are literals, some reference variables and a few are
+// quoted.  The arguments are grouped into commands of ten.
+int benchArgumentExpansion(int argc, char* argv[])
+{
+  int numArgs = argc > 1 ? atoi(argv[1]) : 100000;
+  const int argsPerCommand = 10;
+
+  cmake cm;
+  cmGlobalGenerator* gg = new cmGlobalGenerator;
+  gg->SetCMakeInstance(&cm);
+  cm.SetGlobalGenerator(gg);
+  cmsys::auto_ptr<cmLocalGenerator> lg(gg->CreateLocalGenerator());
+  cmMakefile* mf = lg->GetMakefile();
+  mf->AddDefinition("SRC", "src");
+  mf->AddDefinition("FLAGS", "-O2;-g");
+
+  const char* file = "bench.cmake";
+  std::vector<std::vector<cmListFileArgument> > commands;
+  std::vector<cmListFileArgument> args;
+  size_t expected = 0;
+  for(int i = 0; i < numArgs; ++i)
+    {
+    char value[64];
+    if(i % 10 == 0)
+      {
+      sprintf(value, "${SRC}/file%d.c", i);
+      args.push_back(cmListFileArgument(value, cmListFileArgument::Unquoted,
+                                        file, i));
+      expected += 1;
+      }
+    else if(i % 10 == 1)
+      {
+      args.push_back(cmListFileArgument("${FLAGS}",
+                                        cmListFileArgument::Unquoted,
+                                        file, i));
+      expected += 2;
+      }
+    else if(i % 10 == 2)
+      {
+      sprintf(value, "quoted text %d", i);
+      args.push_back(cmListFileArgument(value, cmListFileArgument::Quoted,
+                                        file, i));
+      expected += 1;
+      }
+    else
+      {
+      sprintf(value, "literal_%d", i);
+      args.push_back(cmListFileArgument(value, cmListFileArgument::Unquoted,
+                                        file, i));
+      expected += 1;
+      }
+    if(static_cast<int>(args.size()) == argsPerCommand || i + 1 == numArgs)
+      {
+      commands.push_back(args);
+      args.clear();
+      }
+    }
+
+  int failed = 0;
+  size_t count = 0;
+  std::vector<std::string> outArgs;
+  double start = cmSystemTools::GetTime();
+  for(std::vector<std::vector<cmListFileArgument> >::const_iterator
+        ci = commands.begin(); ci != commands.end(); ++ci)
+    {
+    outArgs.clear();
+    if(!mf->ExpandArguments(*ci, outArgs))
+      {
+      failed = 1;
+      }
+    count += outArgs.size();
+    }
+  double elapsed = cmSystemTools::GetTime() - start;
+  if(count != expected)
+    {
+    printf("expected %lu expanded arguments, got %lu\n",
+           static_cast<unsigned long>(expected),
+           static_cast<unsigned long>(count));
+    failed = 1;
+    }
+
+  printf("%d arguments in %lu commands: %.3f s\n", numArgs,
+         static_cast<unsigned long>(commands.size()), elapsed);
+  return failed;
+}
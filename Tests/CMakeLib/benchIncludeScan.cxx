@@ -0,0 +1,148 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2000-2014 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+#include "cmake.h"
+#include "cmDependsC.h"
+#include "cmGlobalGenerator.h"
+#include "cmLocalGenerator.h"
+#include "cmMakefile.h"
+#include "cmSystemTools.h"
+
+#include <cmsys/FStream.hxx>
+#include <stdlib.h>
+
+// Write a header of about 200 lines with a license comment, include
+// guards, a few includes and declarations.
+static unsigned long writeHeader(std::string const& dir, int i, int count)
+{
+  char name[64];
+  sprintf(name, "/h%d.h", i);
+  std::string path = dir + name;
+  {
+  cmsys::ofstream fout(path.c_str());
+  fout << "/*\n";
+  for(int l = 0; l < 12; ++l)
+    {
+    fout << " * Licensed under the terms of the license, line " << l << "\n";
+    }
+  fout << " * #include \"not_included.h\"\n"
+       << " */\n"
+       << "#ifndef H" << i << "_H\n"
+       << "#define H" << i << "_H\n"
+       << "\n"
+       << "#include \"h" << (i + 1) % count << ".h\"\n"
+       << "#include \"h" << (i + 2) % count << ".h\"\n"
+       << "#include <stddef.h>\n"
+       << "\n";
+  for(int l = 0; l < 180; ++l)
+    {
+    if(l % 30 == 0)
+      {
+      fout << "  # if defined(H" << i << "_FEATURE_" << l << ")\n"
+           << "  #  define H" << i << "_HAVE_" << l << " 1\n"
+           << "  # endif\n";
+      }
+    fout << "extern int h" << i << "_function_" << l
+         << "(int first, const char* second); /* Documented. */\n";
+    }
+  fout << "\n#endif\n";
+  }
+  return cmSystemTools::FileLength(path.c_str());
+}
+
+// Time a scan of a synthetic header corpus without any cached results
+// and report the throughput.
+int benchIncludeScan(int argc, char* argv[])
+{
+  int count = argc > 1 ? atoi(argv[1]) : 100;
+  const int passes = 3;
+
+  std::string dir = cmSystemTools::GetCurrentWorkingDirectory();
+  dir += "/benchIncludeScan";
+  std::string includeDir = dir + "/include";
+  std::string targetDir = dir + "/target.dir";
+  cmSystemTools::RemoveADirectory(dir.c_str());
+  cmSystemTools::MakeDirectory(includeDir.c_str());
+  cmSystemTools::MakeDirectory(targetDir.c_str());
+
+  unsigned long bytes = 0;
+  for(int i = 0; i < count; ++i)
+    {
+    bytes += writeHeader(includeDir, i, count);
+    }
+  std::string source = dir + "/main.c";
+  {
+  cmsys::ofstream fout(source.c_str());
+  fout << "#include \"h0.h\"\n"
+       << "int main(void) { return 0; }\n";
+  }
+
+  cmake cm;
+  cm.SetHomeDirectory(dir);
+  cm.SetHomeOutputDirectory(dir);
+  cm.SetStartDirectory(dir);
+  cm.SetStartOutputDirectory(dir);
+  cmGlobalGenerator* gg = new cmGlobalGenerator;
+  gg->SetCMakeInstance(&cm);
+  cm.SetGlobalGenerator(gg);
+  cmsys::auto_ptr<cmLocalGenerator> lg(gg->CreateLocalGenerator());
+  cmMakefile* mf = lg->GetMakefile();
+  mf->SetStartDirectory(dir);
+  mf->SetStartOutputDirectory(dir);
+  mf->MakeStartDirectoriesCurrent();
+  mf->AddDefinition("CMAKE_C_TARGET_INCLUDE_PATH", includeDir.c_str());
+  mf->AddDefinition("CMAKE_DEPENDS_CHECK_C",
+                    (source + ";" + dir + "/main.c.o").c_str());
+
+  int failed = 0;
+  double elapsed = 0;
+  for(int pass = 0; pass < passes; ++pass)
+    {
+    // Start without the results of the previous pass.
+    cmSystemTools::RemoveFile((targetDir + "/C.includecache").c_str());
+    cmSystemTools::RemoveADirectory((dir + "/CMakeFiles").c_str());
+    cmSystemTools::MakeDirectory((dir + "/CMakeFiles").c_str());
+
+    cmOStringStream makeDepends;
+    cmOStringStream internalDepends;
+    std::map<std::string, cmDepends::DependencyVector> validDeps;
+    double start = cmSystemTools::GetTime();
+    {
+    cmDependsC scanner(lg.get(), targetDir.c_str(), "C", &validDeps);
+    scanner.SetLanguage("C");
+    if(!scanner.Write(makeDepends, internalDepends))
+      {
+      failed = 1;
+      }
+    }
+    elapsed += cmSystemTools::GetTime() - start;
+
+    // Every header is reached through the chain of includes.
+    std::string deps = internalDepends.str();
+    int found = 0;
+    for(std::string::size_type pos = deps.find(".h\n");
+        pos != std::string::npos; pos = deps.find(".h\n", pos + 1))
+      {
+      ++found;
+      }
+    if(found != count)
+      {
+      printf("expected %d header dependencies, found %d\n", count, found);
+      failed = 1;
+      }
+    }
+
+  printf("%d passes over %d headers of %lu bytes: %.3f s, %.1f MB/s\n",
+         passes, count, bytes, elapsed,
+         elapsed > 0 ? passes * bytes / elapsed / 1e6 : 0.0);
+  cmSystemTools::RemoveADirectory(dir.c_str());
+  return failed;
+}
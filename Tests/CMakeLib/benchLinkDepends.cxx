@@ -0,0 +1,121 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2000-2014 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+#include "cmake.h"
+#include "cmComputeLinkDepends.h"
+#include "cmGlobalGenerator.h"
+#include "cmLocalGenerator.h"
+#include "cmMakefile.h"
+#include "cmSystemTools.h"
+#include "cmTarget.h"
+
+#include <cmsys/FStream.hxx>
+#include <stdlib.h>
+
+// Time the link dependency computation of a synthetic layered graph
+// of static libraries.  Each library links to three of the layer
+// below, and one executable links to each library of the top layer.
+// The executables are linked in two configurations, as for a
+// multi-configuration generator.
+int benchLinkDepends(int argc, char* argv[])
+{
+  int numLibs = argc > 1 ? atoi(argv[1]) : 200;
+  const int width = numLibs < 500 ? 10 : numLibs / 50;
+  const int layers = (numLibs + width - 1) / width;
+  static const char* configs[] = { "Debug", "Release" };
+
+  std::string dir = cmSystemTools::GetCurrentWorkingDirectory();
+  dir += "/benchLinkDepends";
+  cmSystemTools::MakeDirectory(dir.c_str());
+  std::string source = dir + "/source.c";
+  std::string listFile = dir + "/CMakeLists.txt";
+  {
+  cmsys::ofstream fout(source.c_str());
+  fout << "int f(void) { return 0; }\n";
+  }
+  {
+  cmsys::ofstream fout(listFile.c_str());
+  fout << "cmake_policy(VERSION 2.8.12)\n";
+  for(int k = 0; k < layers; ++k)
+    {
+    for(int i = 0; i < width; ++i)
+      {
+      fout << "add_library(l" << k << "_" << i << " STATIC " << source
+           << ")\n";
+      if(k > 0)
+        {
+        fout << "target_link_libraries(l" << k << "_" << i
+             << " l" << k - 1 << "_" << i
+             << " l" << k - 1 << "_" << (i + 1) % width
+             << " l" << k - 1 << "_" << (i + 3) % width << ")\n";
+        }
+      }
+    }
+  for(int i = 0; i < width; ++i)
+    {
+    fout << "add_executable(e" << i << " " << source << ")\n"
+         << "target_link_libraries(e" << i
+         << " l" << layers - 1 << "_" << i << ")\n";
+    }
+  }
+
+  cmake cm;
+  cmGlobalGenerator* gg = new cmGlobalGenerator;
+  gg->SetCMakeInstance(&cm);
+  cm.SetGlobalGenerator(gg);
+  cmsys::auto_ptr<cmLocalGenerator> lg(gg->CreateLocalGenerator());
+  cmMakefile* mf = lg->GetMakefile();
+
+  int failed = 0;
+  if(!mf->ReadListFile(0, listFile.c_str()))
+    {
+    failed = 1;
+    }
+
+  std::vector<cmTarget const*> heads;
+  for(int i = 0; i < width; ++i)
+    {
+    char name[64];
+    sprintf(name, "e%d", i);
+    if(cmTarget const* head = mf->FindTarget(name))
+      {
+      heads.push_back(head);
+      }
+    }
+
+  size_t items = 0;
+  double start = cmSystemTools::GetTime();
+  for(int c = 0; !failed && c < 2; ++c)
+    {
+    for(std::vector<cmTarget const*>::const_iterator hi = heads.begin();
+        hi != heads.end(); ++hi)
+      {
+      cmComputeLinkDepends cld(*hi, configs[c], *hi);
+      items += cld.Compute().size();
+      }
+    }
+  double elapsed = cmSystemTools::GetTime() - start;
+
+  // Each executable links to at least one library of every layer.
+  if(items < 2 * width * static_cast<size_t>(layers))
+    {
+    printf("expected at least %d link items, got %lu\n",
+           2 * width * layers, static_cast<unsigned long>(items));
+    failed = 1;
+    }
+
+  printf("%d libraries in %d layers and %d executables, "
+         "%lu link items in 2 configurations: %.3f s\n",
+         layers * width, layers, width,
+         static_cast<unsigned long>(items), elapsed);
+  cmSystemTools::RemoveADirectory(dir.c_str());
+  return failed;
+}
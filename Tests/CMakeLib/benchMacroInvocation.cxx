@@ -0,0 +1,93 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2000-2014 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+#include "cmake.h"
+#include "cmGlobalGenerator.h"
+#include "cmLocalGenerator.h"
+#include "cmMakefile.h"
+#include "cmSystemTools.h"
+
+#include <cmsys/FStream.hxx>
+#include <stdlib.h>
+
+// Time invocations of macros with bodies of 10, 50 and 200 lines.
+// Each line uses the macro parameters and ARGN.
+int benchMacroInvocation(int argc, char* argv[])
+{
+  int calls = argc > 1 ? atoi(argv[1]) : 200;
+  static const int lines[] = { 10, 50, 200 };
+
+  cmake cm;
+  cmGlobalGenerator* gg = new cmGlobalGenerator;
+  gg->SetCMakeInstance(&cm);
+  cm.SetGlobalGenerator(gg);
+  cmsys::auto_ptr<cmLocalGenerator> lg(gg->CreateLocalGenerator());
+  cmMakefile* mf = lg->GetMakefile();
+
+  std::string dir = cmSystemTools::GetCurrentWorkingDirectory();
+  std::string defineFile = dir + "/benchMacroDefine.cmake";
+  {
+  cmsys::ofstream fout(defineFile.c_str());
+  for(int m = 0; m < 3; ++m)
+    {
+    fout << "macro(m" << lines[m] << " name kind)\n";
+    for(int l = 0; l < lines[m]; ++l)
+      {
+      fout << "  set(${name}_" << l << " \"${kind}:" << l << "\" ${ARGN})\n";
+      }
+    fout << "endmacro()\n";
+    }
+  }
+
+  int failed = 0;
+  if(!mf->ReadListFile(0, defineFile.c_str()))
+    {
+    failed = 1;
+    }
+  for(int m = 0; !failed && m < 3; ++m)
+    {
+    char name[64];
+    sprintf(name, "/benchMacroCall%d.cmake", lines[m]);
+    std::string callFile = dir + name;
+    {
+    cmsys::ofstream fout(callFile.c_str());
+    for(int c = 0; c < calls; ++c)
+      {
+      fout << "m" << lines[m] << "(v" << c % 10 << " k" << c << ")\n";
+      }
+    }
+
+    double start = cmSystemTools::GetTime();
+    if(!mf->ReadListFile(0, callFile.c_str()))
+      {
+      failed = 1;
+      }
+    double elapsed = cmSystemTools::GetTime() - start;
+    cmSystemTools::RemoveFile(callFile.c_str());
+
+    // The last call to use v9 sets v9_0.
+    char expect[64];
+    sprintf(expect, "k%d:0", (calls - 10) / 10 * 10 + 9);
+    const char* value = mf->GetDefinition("v9_0");
+    if(calls >= 10 && (!value || strcmp(value, expect) != 0))
+      {
+      printf("expected v9_0 to be [%s], got [%s]\n",
+             expect, value ? value : "(null)");
+      failed = 1;
+      }
+
+    printf("%d calls of a %d line macro: %.3f s\n",
+           calls, lines[m], elapsed);
+    }
+
+  cmSystemTools::RemoveFile(defineFile.c_str());
+  return failed;
+}
@@ -0,0 +1,76 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2000-2014 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+#include "cmake.h"
+#include "cmGlobalGenerator.h"
+#include "cmLocalGenerator.h"
+#include "cmMakefile.h"
+#include "cmSystemTools.h"
+
+#include <stdlib.h>
+
+// Time variable set, get, push and pop the way nested function calls
+// use them: each call pushes a scope, sets its arguments and reads
+// variables of the directory.
+int benchVariableScopes(int argc, char* argv[])
+{
+  int calls = argc > 1 ? atoi(argv[1]) : 500;
+  const int depth = 8;
+  const int numVars = 500;
+  const int gets = 50;
+
+  cmake cm;
+  cmGlobalGenerator* gg = new cmGlobalGenerator;
+  gg->SetCMakeInstance(&cm);
+  cm.SetGlobalGenerator(gg);
+  cmsys::auto_ptr<cmLocalGenerator> lg(gg->CreateLocalGenerator());
+  cmMakefile* mf = lg->GetMakefile();
+
+  std::vector<std::string> names;
+  for(int i = 0; i < numVars; ++i)
+    {
+    char name[64];
+    sprintf(name, "VAR_%d", i);
+    names.push_back(name);
+    mf->AddDefinition(names.back(), names.back().c_str());
+    }
+
+  int failed = 0;
+  double start = cmSystemTools::GetTime();
+  for(int n = 0; n < calls; ++n)
+    {
+    for(int d = 0; d < depth; ++d)
+      {
+      mf->PushScope();
+      mf->AddDefinition("ARGC", "2");
+      mf->AddDefinition("ARGV0", "a");
+      mf->AddDefinition("ARGV1", "b");
+      }
+    for(int i = 0; i < gets; ++i)
+      {
+      std::string const& name = names[(n + i * 7) % numVars];
+      const char* value = mf->GetDefinition(name);
+      if(!value || name != value)
+        {
+        failed = 1;
+        }
+      }
+    for(int d = 0; d < depth; ++d)
+      {
+      mf->PopScope();
+      }
+    }
+  double elapsed = cmSystemTools::GetTime() - start;
+
+  printf("%d calls %d deep, each with %d sets and %d gets: %.3f s\n",
+         calls, depth, 3 * depth, gets, elapsed);
+  return failed;
+}
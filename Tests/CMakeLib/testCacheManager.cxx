@@ -0,0 +1,61 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2000-2009 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+#include "cmCacheManager.h"
+
+struct test_entry
+{
+  const char* entry;
+  bool parsed;
+  const char* var;
+  const char* value;
+  cmCacheManager::CacheEntryType type;
+};
+
+static test_entry const entries[] = {
+  {"A:BOOL=ON", true, "A", "ON", cmCacheManager::BOOL},
+  {"A:INTERNAL=", true, "A", "", cmCacheManager::INTERNAL},
+  {"A:PATH=a=b", true, "A", "a=b", cmCacheManager::PATH},
+  {"A:STRING=x y \t\r", true, "A", "x y", cmCacheManager::STRING},
+  {"A:STRING= \t", true, "A", " \t", cmCacheManager::STRING},
+  {"A:STRING=' x '", true, "A", " x ", cmCacheManager::STRING},
+  {"A:NOTYPE=x", true, "A", "x", cmCacheManager::STRING},
+  {"\"a:b\":FILEPATH=c", true, "a:b", "c", cmCacheManager::FILEPATH},
+  {"\"a:b=c\":d", true, "\"a", "c\":d", cmCacheManager::STRING},
+  {"\"A:B\"=C", true, "\"A", "C", cmCacheManager::STRING},
+  {"\"A\"=C ", true, "A", "C", cmCacheManager::UNINITIALIZED},
+  {"A=B", true, "A", "B", cmCacheManager::UNINITIALIZED},
+  {"A:BOOL", false, "", "", cmCacheManager::UNINITIALIZED},
+  {0, false, 0, 0, cmCacheManager::UNINITIALIZED}
+};
+
+int testCacheManager(int, char*[])
+{
+  int result = 0;
+  for(test_entry const* e = entries; e->entry; ++e)
+    {
+    std::string var;
+    std::string value;
+    cmCacheManager::CacheEntryType type = cmCacheManager::UNINITIALIZED;
+    bool parsed = cmCacheManager::ParseEntry(e->entry, var, value, type);
+    if(parsed != e->parsed || var != e->var || value != e->value ||
+       type != e->type)
+      {
+      printf("entry [%s]: expected %d [%s] [%s] %s, got %d [%s] [%s] %s\n",
+             e->entry, e->parsed, e->var, e->value,
+             cmCacheManager::TypeToString(e->type),
+             parsed, var.c_str(), value.c_str(),
+             cmCacheManager::TypeToString(type));
+      result = 1;
+      }
+    }
+  return result;
+}
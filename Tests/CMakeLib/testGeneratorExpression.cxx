@@ -0,0 +1,101 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2000-2009 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+#include "cmake.h"
+#include "cmGeneratorExpression.h"
+#include "cmGlobalGenerator.h"
+#include "cmLocalGenerator.h"
+#include "cmMakefile.h"
+#include "cmTarget.h"
+
+static bool testEvaluate(cmCompiledGeneratorExpression const& cge,
+                         cmMakefile* mf, const char* config,
+                         cmTarget const* head, const char* expect)
+{
+  std::string result = cge.Evaluate(mf, config, false, head);
+  if(result != expect)
+    {
+    printf("expression [%s] for config [%s] and target [%s]:\n"
+           "  expected [%s], got [%s]\n",
+           cge.GetInput().c_str(), config,
+           head ? head->GetName().c_str() : "",
+           expect, result.c_str());
+    return false;
+    }
+  return true;
+}
+
+int testGeneratorExpression(int, char*[])
+{
+  cmake cm;
+  cmGlobalGenerator* gg = new cmGlobalGenerator;
+  gg->SetCMakeInstance(&cm);
+  cm.SetGlobalGenerator(gg);
+  cmsys::auto_ptr<cmLocalGenerator> lg(gg->CreateLocalGenerator());
+  cmMakefile* mf = lg->GetMakefile();
+
+  cmTarget* a = mf->AddNewTarget(cmTarget::UTILITY, "a");
+  a->SetProperty("P", "pa");
+  cmTarget* b = mf->AddNewTarget(cmTarget::UTILITY, "b");
+  b->SetProperty("P", "pb");
+
+  // Evaluate as while generating, when parse trees are shared and
+  // results may be reused.
+  mf->SetGeneratingBuildSystem();
+
+  int result = 0;
+  cmListFileBacktrace lfbt;
+  cmGeneratorExpression ge(lfbt);
+
+  // One expression evaluated repeatedly for each head and config.
+  const char* input = "$<1:x>-$<CONFIG>-$<TARGET_PROPERTY:P>";
+  cmsys::auto_ptr<cmCompiledGeneratorExpression> cge = ge.Parse(input);
+  cmsys::auto_ptr<cmCompiledGeneratorExpression> cfg =
+    ge.Parse("$<1:x>$<$<CONFIG:Debug>:-debug>");
+  cmsys::auto_ptr<cmCompiledGeneratorExpression> plain =
+    ge.Parse("$<1:x>");
+  for(int i = 0; i < 2; ++i)
+    {
+    if(!testEvaluate(*cge, mf, "Debug", a, "x-Debug-pa") ||
+       !testEvaluate(*cge, mf, "Release", a, "x-Release-pa") ||
+       !testEvaluate(*cge, mf, "Release", b, "x-Release-pb") ||
+       !testEvaluate(*cge, mf, "Debug", b, "x-Debug-pb") ||
+       !testEvaluate(*cfg, mf, "Debug", a, "x-debug") ||
+       !testEvaluate(*cfg, mf, "Release", a, "x") ||
+       !testEvaluate(*cfg, mf, "Debug", b, "x-debug") ||
+       !testEvaluate(*plain, mf, "Debug", a, "x") ||
+       !testEvaluate(*plain, mf, "Release", b, "x"))
+      {
+      result = 1;
+      }
+    }
+
+  // Expressions with the same input share a parse tree.  Each one
+  // keeps it alive for as long as it needs it.
+  cmsys::auto_ptr<cmCompiledGeneratorExpression> same = ge.Parse(input);
+  if(!testEvaluate(*same, mf, "Debug", b, "x-Debug-pb"))
+    {
+    result = 1;
+    }
+  cge.reset();
+  if(!testEvaluate(*same, mf, "Release", a, "x-Release-pa"))
+    {
+    result = 1;
+    }
+  if(same->GetInput() != input)
+    {
+    printf("expected input [%s], got [%s]\n",
+           input, same->GetInput().c_str());
+    result = 1;
+    }
+
+  return result;
+}
@@ -0,0 +1,201 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2000-2014 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+#include "cmListFileCache.h"
+#include "cmSystemTools.h"
+
+#include <cmsys/FStream.hxx>
+
+#define cmPassed(m) std::cout << "Passed: " << m << "\n"
+#define cmFailed(m) std::cout << "FAILED: " << m << "\n"; failed=1
+
+static void writeFile(std::string const& fname, const char* content)
+{
+  cmsys::ofstream fout(fname.c_str(), std::ios::out | std::ios::binary);
+  fout << content;
+}
+
+static bool sameListFile(cmListFile const& a, cmListFile const& b,
+                         std::string const& path)
+{
+  if(a.Functions.size() != b.Functions.size())
+    {
+    return false;
+    }
+  for(size_t i = 0; i < a.Functions.size(); ++i)
+    {
+    cmListFileFunction const& fa = a.Functions[i];
+    cmListFileFunction const& fb = b.Functions[i];
+    if(fa.Name != fb.Name || fa.Line != fb.Line || fb.FilePath != path ||
+       fa.Arguments != fb.Arguments)
+      {
+      return false;
+      }
+    for(size_t j = 0; j < fb.Arguments.size(); ++j)
+      {
+      if(fa.Arguments[j].Line != fb.Arguments[j].Line ||
+         fb.Arguments[j].FilePath != path)
+        {
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+int testListFileCache(int, char*[])
+{
+  int failed = 0;
+  std::string file = "testListFileCache.cmake";
+  std::string cacheFile = "testListFileCache.bin";
+  writeFile(file, "set(a \"b\\nc\" [[d]])\n");
+
+  cmListFile lf;
+  lf.ModifiedTime = cmSystemTools::ModifiedTime(file.c_str());
+  cmListFileFunction f;
+  f.Name = "set";
+  f.FilePath = file;
+  f.Line = 1;
+  f.Arguments.push_back(
+    cmListFileArgument("a", cmListFileArgument::Unquoted, file.c_str(), 1));
+  f.Arguments.push_back(
+    cmListFileArgument("b\nc", cmListFileArgument::Quoted, file.c_str(), 1));
+  f.Arguments.push_back(
+    cmListFileArgument("d", cmListFileArgument::Bracket, file.c_str(), 1));
+  lf.Functions.push_back(f);
+
+  // ----------------------------------------------------------------------
+  // Test in-process lookup.
+  {
+  cmListFileCache cache;
+  if(cache.GetListFile(file))
+    {
+    cmFailed("cmListFileCache returns an entry never added");
+    }
+  cache.AddListFile(file, lf);
+  cmListFile const* cached = cache.GetListFile(file);
+  if(cached && sameListFile(lf, *cached, file))
+    {
+    cmPassed("cmListFileCache returns an added entry");
+    }
+  else
+    {
+    cmFailed("cmListFileCache returns an added entry");
+    }
+  if(cache.Save(cacheFile))
+    {
+    cmPassed("cmListFileCache::Save works");
+    }
+  else
+    {
+    cmFailed("cmListFileCache::Save works");
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Test round trip through the cache file.
+  {
+  cmListFileCache cache;
+  cmListFile const* cached = 0;
+  if(cache.Load(cacheFile) && (cached = cache.GetListFile(file)) &&
+     sameListFile(lf, *cached, file))
+    {
+    cmPassed("cmListFileCache::Load restores saved entries");
+    }
+  else
+    {
+    cmFailed("cmListFileCache::Load restores saved entries");
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Test that a file only touched since it was parsed is still used.
+  {
+  cmListFile older = lf;
+  older.ModifiedTime -= 10;
+  cmListFileCache cache;
+  cache.AddListFile(file, older);
+  cmListFile const* cached = cache.GetListFile(file);
+  if(cached && cached->ModifiedTime == lf.ModifiedTime)
+    {
+    cmPassed("cmListFileCache accepts a touched file");
+    }
+  else
+    {
+    cmFailed("cmListFileCache accepts a touched file");
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Test that a content change is detected even if the size and time
+  // stamp of the file are unchanged.
+  {
+  cmSystemToolsFileTime* ft = cmSystemTools::FileTimeNew();
+  cmSystemTools::FileTimeGet(file.c_str(), ft);
+  writeFile(file, "set(x \"b\\nc\" [[d]])\n");
+  cmSystemTools::FileTimeSet(file.c_str(), ft);
+  cmSystemTools::FileTimeDelete(ft);
+
+  cmListFileCache cache;
+  cache.Load(cacheFile);
+  if(!cache.GetListFile(file))
+    {
+    cmPassed("cmListFileCache detects modified content");
+    }
+  else
+    {
+    cmFailed("cmListFileCache detects modified content");
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Test that a corrupt cache file is rejected.
+  {
+  writeFile(cacheFile, "garbage");
+  cmListFileCache cache;
+  if(!cache.Load(cacheFile) && !cache.GetListFile(file))
+    {
+    cmPassed("cmListFileCache rejects a corrupt cache file");
+    }
+  else
+    {
+    cmFailed("cmListFileCache rejects a corrupt cache file");
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Test that a cache file with an impossible string length is rejected.
+  {
+  std::string content;
+  {
+  cmListFileCache cache;
+  cache.AddListFile(file, lf);
+  cache.Save(cacheFile);
+  cmsys::ifstream fin(cacheFile.c_str(), std::ios::in | std::ios::binary);
+  std::getline(fin, content);
+  content += "\n999999999999999999:";
+  }
+  writeFile(cacheFile, content.c_str());
+  cmListFileCache cache;
+  if(!cache.Load(cacheFile) && !cache.GetListFile(file))
+    {
+    cmPassed("cmListFileCache rejects an oversized length");
+    }
+  else
+    {
+    cmFailed("cmListFileCache rejects an oversized length");
+    }
+  }
+
+  cmSystemTools::RemoveFile(file.c_str());
+  cmSystemTools::RemoveFile(cacheFile.c_str());
+  return failed;
+}
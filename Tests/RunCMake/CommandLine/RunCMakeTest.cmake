@@ -28,3 +28,18 @@ run_cmake_command(E_sleep-no-args ${CMAKE_COMMAND} -E sleep)
 run_cmake_command(E_sleep-bad-arg1 ${CMAKE_COMMAND} -E sleep x)
 run_cmake_command(E_sleep-bad-arg2 ${CMAKE_COMMAND} -E sleep 1 -1)
 run_cmake_command(E_sleep-one-tenth ${CMAKE_COMMAND} -E sleep 0.1)
+
+# Use a single build tree for the progress reported by cmake_echo_color.
+set(RunCMake_TEST_BINARY_DIR
+  ${RunCMake_BINARY_DIR}/E_echo_color-progress-build)
+set(RunCMake_TEST_NO_CLEAN 1)
+file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+run_cmake_command(E_echo_color-progress-start
+  ${CMAKE_COMMAND} -E cmake_progress_start . 4
+  )
+run_cmake_command(E_echo_color-progress
+  ${CMAKE_COMMAND} -E cmake_echo_color --switch=OFF
+    --progress-dir=. --progress-num=1,2 "Built target x"
+  )
+unset(RunCMake_TEST_BINARY_DIR)
+unset(RunCMake_TEST_NO_CLEAN)
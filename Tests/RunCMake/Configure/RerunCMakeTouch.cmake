@@ -0,0 +1,5 @@
+set(stamp ${CMAKE_CURRENT_BINARY_DIR}/CustomCMakeStamp.txt)
+file(GLOB files ${CMAKE_CURRENT_BINARY_DIR}/CustomCMakeGlob/*.txt)
+list(LENGTH files count)
+file(WRITE ${stamp} "${count}")
+include(${CMAKE_CURRENT_BINARY_DIR}/CustomCMakeList.cmake)
@@ -22,3 +22,21 @@ file(WRITE "${depend}" "2")
 run_cmake_command(RerunCMake-build2 ${CMAKE_COMMAND} --build .)
 unset(RunCMake_TEST_BINARY_DIR)
 unset(RunCMake_TEST_NO_CLEAN)
+
+# A touched list file re-runs CMake even if its content is unchanged.
+set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/RerunCMakeTouch-build)
+set(RunCMake_TEST_NO_CLEAN 1)
+file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+set(glob  "${RunCMake_TEST_BINARY_DIR}/CustomCMakeGlob")
+set(list  "${RunCMake_TEST_BINARY_DIR}/CustomCMakeList.cmake")
+set(stamp "${RunCMake_TEST_BINARY_DIR}/CustomCMakeStamp.txt")
+file(WRITE "${glob}/1.txt" "1")
+file(WRITE "${list}" "# Touched by the test.\n")
+run_cmake(RerunCMakeTouch)
+execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 1) # handle 1s resolution
+file(WRITE "${glob}/2.txt" "2")
+execute_process(COMMAND ${CMAKE_COMMAND} -E touch "${list}")
+run_cmake_command(RerunCMakeTouch-build ${CMAKE_COMMAND} --build .)
+unset(RunCMake_TEST_BINARY_DIR)
+unset(RunCMake_TEST_NO_CLEAN)
@@ -0,0 +1,29 @@
+enable_language(C)
+set(CMAKE_TRY_COMPILE_RESULT_CACHE ${CMAKE_CURRENT_BINARY_DIR}/ResultCache)
+file(REMOVE_RECURSE ${CMAKE_TRY_COMPILE_RESULT_CACHE})
+
+try_compile(RESULT ${CMAKE_CURRENT_BINARY_DIR} ${CMAKE_CURRENT_SOURCE_DIR}/src.c
+  OUTPUT_VARIABLE out)
+if(NOT RESULT)
+  message(FATAL_ERROR "try_compile failed:\n${out}")
+endif()
+file(GLOB entries ${CMAKE_TRY_COMPILE_RESULT_CACHE}/*.txt)
+list(LENGTH entries n)
+if(NOT n EQUAL 1)
+  message(FATAL_ERROR "try_compile stored ${n} results:\n  ${entries}")
+endif()
+
+# Replace the stored result to see that the next call uses it.
+file(WRITE ${entries} "COMPILE_OUTPUT\n10:stored\nout\nCOMPILE_RESULT\n1:1\n")
+try_compile(RESULT ${CMAKE_CURRENT_BINARY_DIR} ${CMAKE_CURRENT_SOURCE_DIR}/src.c
+  OUTPUT_VARIABLE out)
+if(RESULT OR NOT out STREQUAL "stored\nout")
+  message(FATAL_ERROR "try_compile did not use the stored result:\n${out}")
+endif()
+
+# A different project must not use it.
+try_compile(RESULT ${CMAKE_CURRENT_BINARY_DIR} ${CMAKE_CURRENT_SOURCE_DIR}/src.c
+  COMPILE_DEFINITIONS -DRESULT_CACHE OUTPUT_VARIABLE out)
+if(NOT RESULT)
+  message(FATAL_ERROR "try_compile used an unrelated result:\n${out}")
+endif()
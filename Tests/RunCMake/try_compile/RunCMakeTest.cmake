@@ -15,3 +15,4 @@ run_cmake(BadSources1)
 run_cmake(BadSources2)
 run_cmake(NonSourceCopyFile)
 run_cmake(NonSourceCompileDefinitions)
+run_cmake(ResultCache)